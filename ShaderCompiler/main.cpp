@@ -0,0 +1,638 @@
+/*!
+ * ShaderCompiler
+ * ****************************************************************
+ * Offline shader build stage. Compiles every GLSL source in a
+ * directory to SPIR-V in-process with shaderc, one worker per core.
+ *
+ * Output goes into a content-addressed cache, where each module is
+ * named after a hash of its preprocessed source, stage and defines.
+ * Shaders whose key already exists in the cache are not recompiled.
+ * A manifest mapping source names to keys is written alongside.
+ *
+ * Compiled modules then go through spirv-tools: performance passes
+ * by default or size passes with -O size, and debug info (names,
+ * source text, GL_GOOGLE_* source extensions) is stripped unless -g
+ * is given. -O none skips spirv-tools and keeps modules exactly as
+ * shaderc compiles them, the same as glslc's default output, and
+ * -O none -g adds full debug info for shader debuggers. Sizes
+ * before and after are reported.
+ *
+ * With -a the current modules are packed into a single archive that
+ * the runtime (JZvk::Shader) memory maps, and with -e the archive is
+ * also written as a C++ array to embed in the executable.
+ *
+ * usage: ShaderCompiler <shader dir> [-o <cache dir>] [-j <jobs>]
+ *                       [-a <archive>] [-e <embed header>]
+ *                       [-O none|size|performance] [-g]
+ *                       [-D NAME[=VALUE]]...
+ * ****************************************************************
+*/
+#include <shaderc/shaderc.hpp>
+#include <spirv-tools/optimizer.hpp>
+
+/* PROJECT INCLUDES */
+#include "../VulkanBasics/src/internal/shaders/JZvk_ShaderArchive.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// bump when compile options change so stale cache entries are not reused
+static char const* const TOOL_VERSION = "JZvkShaderCompiler-2";
+
+enum class Optimization
+{
+	NONE ,
+	SIZE ,
+	PERFORMANCE
+};
+
+struct ShaderJob
+{
+	fs::path source_path_;
+	shaderc_shader_kind kind_;
+	std::string key_;
+	bool cached_ { false };
+	bool failed_ { false };
+	std::string message_;
+	// in bytes, as compiled and after optimizing and stripping, zero for cached modules
+	size_t compiled_size_ { 0 };
+	size_t size_ { 0 };
+};
+
+struct Settings
+{
+	fs::path shader_directory_;
+	fs::path cache_directory_;
+	fs::path archive_path_;
+	fs::path embed_path_;
+	unsigned int jobs_ { 0 };
+	std::vector<std::pair<std::string , std::string>> defines_;
+	Optimization optimization_ { Optimization::PERFORMANCE };
+	bool strip_debug_ { true };
+};
+
+/*!
+ * HELPERS - START
+ * ****************************************************************
+*/
+static bool ShaderKindFromExtension ( fs::path const& path , shaderc_shader_kind& kind )
+{
+	static std::map<std::string , shaderc_shader_kind> const kinds = {
+		{ ".vert" , shaderc_vertex_shader },
+		{ ".frag" , shaderc_fragment_shader },
+		{ ".comp" , shaderc_compute_shader },
+		{ ".geom" , shaderc_geometry_shader },
+		{ ".tesc" , shaderc_tess_control_shader },
+		{ ".tese" , shaderc_tess_evaluation_shader }
+	};
+
+	auto it = kinds.find ( path.extension ().string () );
+	if ( it == kinds.end () )
+	{
+		return false;
+	}
+	kind = it->second;
+	return true;
+}
+
+static bool ReadText ( fs::path const& path , std::string& text )
+{
+	std::ifstream file ( path , std::ios::binary );
+	if ( !file.is_open () )
+	{
+		return false;
+	}
+	std::ostringstream stream;
+	stream << file.rdbuf ();
+	text = stream.str ();
+	return true;
+}
+
+// 64 bit FNV-1a, stable across platforms and runs
+static void HashBytes ( uint64_t& hash , void const* data , size_t size )
+{
+	unsigned char const* bytes = static_cast< unsigned char const* >( data );
+	for ( size_t i = 0; i < size; ++i )
+	{
+		hash ^= bytes[ i ];
+		hash *= 0x100000001b3ull;
+	}
+}
+
+static void HashString ( uint64_t& hash , std::string const& text )
+{
+	HashBytes ( hash , text.data () , text.size () );
+	// separator so ("ab","c") and ("a","bc") hash differently
+	HashBytes ( hash , "\0" , 1 );
+}
+
+static std::string ToHex ( uint64_t value )
+{
+	char buffer[ 17 ];
+	std::snprintf ( buffer , sizeof ( buffer ) , "%016llx" , static_cast< unsigned long long >( value ) );
+	return buffer;
+}
+/*!
+ * HELPERS - END
+ * ****************************************************************
+*/
+
+/*!
+ * INCLUDER - START
+ * ****************************************************************
+*/
+// resolves #include relative to the including file, then the shader directory
+class FileIncluder : public shaderc::CompileOptions::IncluderInterface
+{
+public:
+	explicit FileIncluder ( fs::path root ) : root_ ( std::move ( root ) ) {}
+
+	shaderc_include_result* GetInclude ( char const* requestedSource , shaderc_include_type type ,
+										 char const* requestingSource , size_t includeDepth ) override
+	{
+		( void ) includeDepth;
+
+		auto* include = new Include ();
+		fs::path candidate = type == shaderc_include_type_relative
+			? fs::path ( requestingSource ).parent_path () / requestedSource
+			: root_ / requestedSource;
+		if ( !fs::exists ( candidate ) )
+		{
+			candidate = root_ / requestedSource;
+		}
+
+		if ( ReadText ( candidate , include->content_ ) )
+		{
+			include->name_ = candidate.string ();
+		}
+		else
+		{
+			// empty source name signals failure, content holds the error
+			include->content_ = "cannot open include file " + std::string ( requestedSource );
+		}
+
+		include->result_.source_name = include->name_.c_str ();
+		include->result_.source_name_length = include->name_.size ();
+		include->result_.content = include->content_.c_str ();
+		include->result_.content_length = include->content_.size ();
+		include->result_.user_data = include;
+		return &include->result_;
+	}
+
+	void ReleaseInclude ( shaderc_include_result* data ) override
+	{
+		delete static_cast< Include* >( data->user_data );
+	}
+
+private:
+	struct Include
+	{
+		shaderc_include_result result_ {};
+		std::string name_;
+		std::string content_;
+	};
+
+	fs::path root_;
+};
+/*!
+ * INCLUDER - END
+ * ****************************************************************
+*/
+
+static shaderc::CompileOptions MakeOptions ( Settings const& settings )
+{
+	shaderc::CompileOptions options;
+	options.SetTargetEnvironment ( shaderc_target_env_vulkan , shaderc_env_version_vulkan_1_0 );
+	options.SetIncluder ( std::make_unique<FileIncluder> ( settings.shader_directory_ ) );
+	if ( !settings.strip_debug_ )
+	{
+		options.SetGenerateDebugInfo ();
+	}
+	for ( auto const& define : settings.defines_ )
+	{
+		options.AddMacroDefinition ( define.first , define.second );
+	}
+	return options;
+}
+
+// optimizes and strips a compiled module in place, spirv-tools validates it before running the passes.
+// -O none leaves it as compiled, -g already decided whether debug info was generated
+static bool ProcessModule ( Settings const& settings , std::vector<uint32_t>& words , std::string& message )
+{
+	if ( settings.optimization_ == Optimization::NONE )
+	{
+		return true;
+	}
+
+	spvtools::Optimizer optimizer ( SPV_ENV_VULKAN_1_0 );
+	optimizer.SetMessageConsumer ( [ &message ] ( spv_message_level_t level , char const* , spv_position_t const& , char const* text )
+								   {
+									   if ( level <= SPV_MSG_ERROR )
+									   {
+										   message += text;
+										   message += '\n';
+									   }
+								   } );
+
+	if ( settings.optimization_ == Optimization::PERFORMANCE )
+	{
+		optimizer.RegisterPerformancePasses ();
+	}
+	else if ( settings.optimization_ == Optimization::SIZE )
+	{
+		optimizer.RegisterSizePasses ();
+	}
+
+	// last, so nothing the optimizer adds back survives
+	if ( settings.strip_debug_ )
+	{
+		optimizer.RegisterPass ( spvtools::CreateStripDebugInfoPass () );
+		optimizer.RegisterPass ( spvtools::CreateStripNonSemanticInfoPass () );
+	}
+
+	std::vector<uint32_t> processed;
+	if ( !optimizer.Run ( words.data () , words.size () , &processed ) )
+	{
+		return false;
+	}
+	words = std::move ( processed );
+	return true;
+}
+
+static void CompileJob ( shaderc::Compiler const& compiler , Settings const& settings , ShaderJob& job )
+{
+	std::string source;
+	if ( !ReadText ( job.source_path_ , source ) )
+	{
+		job.failed_ = true;
+		job.message_ = "failed to read source";
+		return;
+	}
+
+	std::string const name = job.source_path_.filename ().string ();
+
+	// key on the preprocessed text so edits to included files invalidate too
+	shaderc::PreprocessedSourceCompilationResult preprocessed =
+		compiler.PreprocessGlsl ( source , job.kind_ , job.source_path_.string ().c_str () , MakeOptions ( settings ) );
+	if ( preprocessed.GetCompilationStatus () != shaderc_compilation_status_success )
+	{
+		job.failed_ = true;
+		job.message_ = preprocessed.GetErrorMessage ();
+		return;
+	}
+	std::string const preprocessed_source ( preprocessed.cbegin () , preprocessed.cend () );
+
+	uint64_t hash { 0xcbf29ce484222325ull };
+	HashString ( hash , TOOL_VERSION );
+	HashBytes ( hash , &job.kind_ , sizeof ( job.kind_ ) );
+	HashBytes ( hash , &settings.optimization_ , sizeof ( settings.optimization_ ) );
+	HashBytes ( hash , &settings.strip_debug_ , sizeof ( settings.strip_debug_ ) );
+	for ( auto const& define : settings.defines_ )
+	{
+		HashString ( hash , define.first );
+		HashString ( hash , define.second );
+	}
+	HashString ( hash , preprocessed_source );
+	job.key_ = ToHex ( hash );
+
+	fs::path const output_path = settings.cache_directory_ / ( job.key_ + ".spv" );
+	if ( fs::exists ( output_path ) )
+	{
+		job.cached_ = true;
+		job.size_ = static_cast< size_t >( fs::file_size ( output_path ) );
+		return;
+	}
+
+	shaderc::SpvCompilationResult module =
+		compiler.CompileGlslToSpv ( preprocessed_source , job.kind_ , name.c_str () , MakeOptions ( settings ) );
+	if ( module.GetCompilationStatus () != shaderc_compilation_status_success )
+	{
+		job.failed_ = true;
+		job.message_ = module.GetErrorMessage ();
+		return;
+	}
+
+	std::vector<uint32_t> words ( module.cbegin () , module.cend () );
+	job.compiled_size_ = words.size () * sizeof ( uint32_t );
+	if ( !ProcessModule ( settings , words , job.message_ ) )
+	{
+		job.failed_ = true;
+		job.message_ = "spirv-tools failed\n" + job.message_;
+		return;
+	}
+	job.size_ = words.size () * sizeof ( uint32_t );
+
+	// write to a temporary then rename, so a concurrent run never sees half a module
+	fs::path const temp_path = settings.cache_directory_ / ( job.key_ + ".spv." + std::to_string ( std::hash<std::thread::id> {}( std::this_thread::get_id () ) ) );
+	{
+		std::ofstream file ( temp_path , std::ios::binary | std::ios::trunc );
+		file.write ( reinterpret_cast< char const* >( words.data () ) , static_cast< std::streamsize >( job.size_ ) );
+		if ( !file.good () )
+		{
+			job.failed_ = true;
+			job.message_ = "failed to write " + temp_path.string ();
+			return;
+		}
+	}
+	std::error_code error;
+	fs::rename ( temp_path , output_path , error );
+	if ( error )
+	{
+		fs::remove ( temp_path , error );
+	}
+}
+
+/*!
+ * ARCHIVE - START
+ * ****************************************************************
+*/
+// packs the current module of every job, sorted by name, see JZvk_ShaderArchive.h
+static bool BuildArchive ( Settings const& settings , std::vector<ShaderJob> const& jobs , std::vector<uint32_t>& archive )
+{
+	std::vector<JZvk::ShaderArchiveEntry> entries;
+	std::vector<std::string> blobs;
+	for ( auto const& job : jobs )
+	{
+		std::string const name = job.source_path_.filename ().string ();
+		if ( name.size () >= JZvk::SHADER_ARCHIVE_NAME_SIZE )
+		{
+			std::cerr << name << ": name too long for the shader archive" << std::endl;
+			return false;
+		}
+
+		std::string blob;
+		if ( !ReadText ( settings.cache_directory_ / ( job.key_ + ".spv" ) , blob ) || blob.size () % 4 != 0 )
+		{
+			std::cerr << name << ": cached module missing or malformed" << std::endl;
+			return false;
+		}
+
+		JZvk::ShaderArchiveEntry entry {};
+		std::memcpy ( entry.name_ , name.c_str () , name.size () + 1 );
+		entry.size_ = static_cast< uint32_t >( blob.size () );
+		entries.push_back ( entry );
+		blobs.push_back ( std::move ( blob ) );
+	}
+
+	// blob sizes are whole words, so every offset stays 4 byte aligned
+	size_t offset = sizeof ( JZvk::ShaderArchiveHeader ) + entries.size () * sizeof ( JZvk::ShaderArchiveEntry );
+	for ( size_t i = 0; i < entries.size (); ++i )
+	{
+		entries[ i ].offset_ = static_cast< uint32_t >( offset );
+		offset += blobs[ i ].size ();
+	}
+
+	JZvk::ShaderArchiveHeader header {};
+	header.magic_ = JZvk::SHADER_ARCHIVE_MAGIC;
+	header.version_ = JZvk::SHADER_ARCHIVE_VERSION;
+	header.entry_count_ = static_cast< uint32_t >( entries.size () );
+	header.total_size_ = static_cast< uint32_t >( offset );
+
+	archive.assign ( offset / 4 , 0 );
+	unsigned char* bytes = reinterpret_cast< unsigned char* >( archive.data () );
+	std::memcpy ( bytes , &header , sizeof ( header ) );
+	if ( !entries.empty () )
+	{
+		std::memcpy ( bytes + sizeof ( header ) , entries.data () , entries.size () * sizeof ( JZvk::ShaderArchiveEntry ) );
+	}
+	for ( size_t i = 0; i < entries.size (); ++i )
+	{
+		std::memcpy ( bytes + entries[ i ].offset_ , blobs[ i ].data () , blobs[ i ].size () );
+	}
+	return true;
+}
+
+// the archive as a constexpr word array, included by JZvk_Shader.cpp with JZVK_EMBED_SHADER_ARCHIVE
+static bool WriteEmbedHeader ( fs::path const& path , std::vector<uint32_t> const& archive )
+{
+	std::ofstream file ( path , std::ios::trunc );
+	file << "// generated by ShaderCompiler, do not edit\n";
+	file << "#pragma once\n#include <cstdint>\n\n";
+	file << "alignas ( 4 ) constexpr uint32_t SHADER_ARCHIVE_WORDS[] = {";
+	for ( size_t i = 0; i < archive.size (); ++i )
+	{
+		char word[ 16 ];
+		std::snprintf ( word , sizeof ( word ) , "0x%08x," , archive[ i ] );
+		file << ( i % 8 == 0 ? "\n\t" : " " ) << word;
+	}
+	file << "\n};\n";
+	return file.good ();
+}
+/*!
+ * ARCHIVE - END
+ * ****************************************************************
+*/
+
+static bool ParseArguments ( int argc , char** argv , Settings& settings )
+{
+	for ( int i = 1; i < argc; ++i )
+	{
+		std::string const argument = argv[ i ];
+		if ( argument == "-o" && i + 1 < argc )
+		{
+			settings.cache_directory_ = argv[ ++i ];
+		}
+		else if ( argument == "-a" && i + 1 < argc )
+		{
+			settings.archive_path_ = argv[ ++i ];
+		}
+		else if ( argument == "-e" && i + 1 < argc )
+		{
+			settings.embed_path_ = argv[ ++i ];
+		}
+		else if ( argument == "-O" && i + 1 < argc )
+		{
+			std::string const level = argv[ ++i ];
+			if ( level == "none" )
+			{
+				settings.optimization_ = Optimization::NONE;
+			}
+			else if ( level == "size" )
+			{
+				settings.optimization_ = Optimization::SIZE;
+			}
+			else if ( level == "performance" )
+			{
+				settings.optimization_ = Optimization::PERFORMANCE;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		else if ( argument == "-g" )
+		{
+			settings.strip_debug_ = false;
+		}
+		else if ( argument == "-j" && i + 1 < argc )
+		{
+			settings.jobs_ = static_cast< unsigned int >( std::stoul ( argv[ ++i ] ) );
+		}
+		else if ( argument.rfind ( "-D" , 0 ) == 0 )
+		{
+			std::string define = argument.size () > 2 ? argument.substr ( 2 ) : ( i + 1 < argc ? argv[ ++i ] : "" );
+			size_t const equals = define.find ( '=' );
+			if ( equals == std::string::npos )
+			{
+				settings.defines_.emplace_back ( define , "" );
+			}
+			else
+			{
+				settings.defines_.emplace_back ( define.substr ( 0 , equals ) , define.substr ( equals + 1 ) );
+			}
+		}
+		else if ( settings.shader_directory_.empty () )
+		{
+			settings.shader_directory_ = argument;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if ( settings.shader_directory_.empty () )
+	{
+		return false;
+	}
+	if ( settings.cache_directory_.empty () )
+	{
+		settings.cache_directory_ = settings.shader_directory_ / "cache";
+	}
+	if ( settings.jobs_ == 0 )
+	{
+		settings.jobs_ = std::max ( 1u , std::thread::hardware_concurrency () );
+	}
+	// define order must not change the key
+	std::sort ( settings.defines_.begin () , settings.defines_.end () );
+	return true;
+}
+
+int main ( int argc , char** argv )
+{
+	Settings settings;
+	if ( !ParseArguments ( argc , argv , settings ) )
+	{
+		std::cerr << "usage: ShaderCompiler <shader dir> [-o <cache dir>] [-j <jobs>] [-a <archive>] [-e <embed header>] [-O none|size|performance] [-g] [-D NAME[=VALUE]]..." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto const start = std::chrono::steady_clock::now ();
+
+	std::vector<ShaderJob> jobs;
+	for ( auto const& entry : fs::directory_iterator ( settings.shader_directory_ ) )
+	{
+		ShaderJob job;
+		if ( entry.is_regular_file () && ShaderKindFromExtension ( entry.path () , job.kind_ ) )
+		{
+			job.source_path_ = entry.path ();
+			jobs.push_back ( std::move ( job ) );
+		}
+	}
+	fs::create_directories ( settings.cache_directory_ );
+
+	// workers pull jobs off a shared counter, one compiler instance each
+	std::atomic<size_t> next_job { 0 };
+	std::vector<std::thread> workers;
+	unsigned int const worker_count = std::min<unsigned int> ( settings.jobs_ , static_cast< unsigned int >( std::max<size_t> ( 1 , jobs.size () ) ) );
+	for ( unsigned int i = 0; i < worker_count; ++i )
+	{
+		workers.emplace_back ( [ & ] ()
+							   {
+								   shaderc::Compiler compiler;
+								   for ( size_t job = next_job++; job < jobs.size (); job = next_job++ )
+								   {
+									   CompileJob ( compiler , settings , jobs[ job ] );
+								   }
+							   } );
+	}
+	for ( auto& worker : workers )
+	{
+		worker.join ();
+	}
+
+	// report and write manifest, sorted by name so it diffs cleanly
+	std::sort ( jobs.begin () , jobs.end () , [] ( ShaderJob const& a , ShaderJob const& b ) { return a.source_path_.filename () < b.source_path_.filename (); } );
+
+	size_t compiled { 0 } , cached { 0 } , failed { 0 };
+	size_t compiled_bytes { 0 } , processed_bytes { 0 };
+	std::ostringstream manifest;
+	for ( auto const& job : jobs )
+	{
+		std::string const name = job.source_path_.filename ().string ();
+		if ( job.failed_ )
+		{
+			++failed;
+			std::cerr << name << ": " << job.message_ << std::endl;
+			continue;
+		}
+		job.cached_ ? ++cached : ++compiled;
+		std::cout << ( job.cached_ ? "  cached   " : "  compiled " ) << name << " -> " << job.key_ << ".spv, ";
+		if ( job.cached_ )
+		{
+			std::cout << job.size_ << " bytes" << std::endl;
+		}
+		else
+		{
+			compiled_bytes += job.compiled_size_;
+			processed_bytes += job.size_;
+			std::cout << job.compiled_size_ << " -> " << job.size_ << " bytes" << std::endl;
+		}
+		manifest << name << ' ' << job.key_ << '\n';
+	}
+
+	if ( failed == 0 )
+	{
+		std::ofstream file ( settings.cache_directory_ / "manifest.txt" , std::ios::trunc );
+		file << manifest.str ();
+	}
+
+	if ( failed == 0 && ( !settings.archive_path_.empty () || !settings.embed_path_.empty () ) )
+	{
+		std::vector<uint32_t> archive;
+		if ( !BuildArchive ( settings , jobs , archive ) )
+		{
+			return EXIT_FAILURE;
+		}
+
+		if ( !settings.archive_path_.empty () )
+		{
+			std::ofstream file ( settings.archive_path_ , std::ios::binary | std::ios::trunc );
+			file.write ( reinterpret_cast< char const* >( archive.data () ) , static_cast< std::streamsize >( archive.size () * sizeof ( uint32_t ) ) );
+			std::cout << "archive " << settings.archive_path_.string () << ", " << archive.size () * sizeof ( uint32_t ) << " bytes" << std::endl;
+		}
+		if ( !settings.embed_path_.empty () && !WriteEmbedHeader ( settings.embed_path_ , archive ) )
+		{
+			std::cerr << "failed to write " << settings.embed_path_.string () << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	auto const elapsed = std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count ();
+	std::cout << compiled << " compiled, " << cached << " cached, " << failed << " failed in "
+		<< elapsed << " ms on " << worker_count << " threads" << std::endl;
+	if ( compiled > 0 )
+	{
+		std::cout << "optimizing and stripping took compiled modules from " << compiled_bytes << " to " << processed_bytes << " bytes" << std::endl;
+	}
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
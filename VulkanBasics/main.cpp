@@ -11,17 +11,75 @@
 #include <set>
 #include <cstdint>
 #include <algorithm>
+#include <chrono>
+#include <map>
+#include <atomic>
+#include <sstream>
+#include <thread>
 #include <fstream>
+#include <limits>
+#include <cmath>
 
 /* PROJECT INCLUDES */
 #include "src/internal/tools/JZvk_Support.h"
 #include "src/internal/debug/JZvk_Debug.h"
 #include "src/internal/debug/JZvk_Log.h"
+#include "src/internal/debug/JZvk_ValidationSink.h"
 #include "src/internal/tools/JZvk_Create.h"
+#include "src/internal/tools/JZvk_DeviceDispatch.h"
+#include "src/internal/tools/JZvk_StartupGraph.h"
+#include "src/internal/shaders/JZvk_Shader.h"
+#include "src/internal/shaders/JZvk_ShaderPermutation.h"
+#include "src/internal/pipeline/JZvk_PipelineCache.h"
+#include "src/internal/pipeline/JZvk_DynamicState.h"
+#include "src/internal/pipeline/JZvk_PipelineLibrary.h"
+#include "src/internal/descriptors/JZvk_DescriptorLayoutCache.h"
+#include "src/internal/descriptors/JZvk_DescriptorAllocator.h"
+#include "src/internal/descriptors/JZvk_BindlessTable.h"
+#include "src/internal/descriptors/JZvk_TransientBindings.h"
+#include "src/internal/memory/JZvk_Buffer.h"
+#include "src/internal/memory/JZvk_UniformRing.h"
+#include "src/internal/bench/JZvk_Bench.h"
+#include "src/internal/bench/JZvk_Histogram.h"
+#include "src/internal/bench/JZvk_SceneGenerator.h"
+#include "src/internal/swapchain/JZvk_PresentPolicy.h"
+#include "src/internal/swapchain/JZvk_OffscreenTargets.h"
+#include "src/internal/capture/JZvk_FrameReadback.h"
+#include "src/internal/resolution/JZvk_DynamicResolution.h"
+#include "src/internal/profiling/JZvk_GpuProfiler.h"
+#include "src/internal/profiling/JZvk_PipelineStatistics.h"
+#include "src/internal/profiling/JZvk_CpuProfiler.h"
 
 const uint32_t WIDTH = 800;
 const uint32_t HEIGHT = 600;
-const int MAX_FRAMES_IN_FLIGHT = 2;
+const uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+const uint32_t MAX_FRAMES_IN_FLIGHT = 8;   // upper bound of --frames-in-flight
+const char* PIPELINE_CACHE_FILE = "pipeline_cache.bin";
+const uint32_t MAX_OBJECTS_PER_FRAME = 1024;
+
+// descriptor set indices of the pipeline layout
+const uint32_t BINDLESS_SET = 0;    // bindless table, or an empty set without descriptor indexing
+const uint32_t DRAW_SET = 1;        // per draw bindings, see JZvk::TransientBindings. only the pushdescriptors benchmark binds it
+const uint32_t OBJECT_SET = 2;      // per object uniforms, see JZvk::UniformRing
+
+// push constant block of material.glsl, resource indices address the bindless table
+struct MaterialConstants
+{
+    JZvk::PermutationKey features;
+    uint32_t textureIndex = JZvk::BindlessTable::INVALID_INDEX;
+    uint32_t bufferIndex = JZvk::BindlessTable::INVALID_INDEX;
+};
+
+// per object block of shader.vert, pushed after MaterialConstants when it fits
+struct ObjectUniforms
+{
+    float transform[ 4 ] = { 0.0f , 0.0f , 1.0f , 1.0f };  // xy offset, zw scale
+};
+
+const uint32_t OBJECT_PUSH_OFFSET = 16;
+static_assert ( sizeof ( MaterialConstants ) <= OBJECT_PUSH_OFFSET , "object push constants overlap the material" );
+// 128 bytes is the smallest maxPushConstantsSize allowed, shader.vert declares both blocks
+static_assert ( OBJECT_PUSH_OFFSET + sizeof ( ObjectUniforms ) <= 128 , "object push constants exceed the guaranteed range" );
 
 /*!
  * VULKAN DEBUG FUNCTIONS - START
@@ -33,11 +91,8 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityF
                                                     const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,  // struct containing data relating to the callback
                                                     void* pUserData )                                           // custom data
 {
-    UNRERENCED_PARAMETER(messageSeverity);
-    UNRERENCED_PARAMETER(messageType);
-    UNRERENCED_PARAMETER(pUserData);
-
-    std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+    // filtered, deduplicated and written to std::cerr on the sink's own thread
+    static_cast< JZvk::ValidationSink* >( pUserData )->Submit ( messageSeverity , messageType , *pCallbackData );
     // should always return false, i.e. not abort function call that triggered this callback
     return VK_FALSE;
 }
@@ -81,84 +136,155 @@ void DestroyDebugUtilsMessengerEXT( VkInstance instance,
 void PopulateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo)
 {
     createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-    // flag possible problems
-    createInfo.messageSeverity =    VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT |
-                                    VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
-                                    VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-
-    createInfo.messageType =        VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
-                                    VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
-                                    VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    // only what the sink reports, the layers skip formatting everything else
+    JZvk::ValidationSink& sink = JZvk::GetValidationSink ();
+    createInfo.messageSeverity =    sink.Severities ();
+    createInfo.messageType =        sink.Types ();
 
     // debug call back function defined above 
     createInfo.pfnUserCallback = debugCallback;
 
-    createInfo.pUserData = nullptr;
+    createInfo.pUserData = &sink;
 }
 /*!
  * VULKAN DEBUG FUNCTIONS - END
  * ****************************************************************
 */
 
-/*!
- * SHADER READING FUNCTIONS - START
- * ****************************************************************
-*/
-
-static std::vector<char> readFile ( std::string const& filename )
+// command line options, see main
+struct AppOptions
 {
-    std::ifstream file ( filename , std::ios::ate | std::ios::binary );
-
-    if ( !file.is_open () )
-    {
-        throw std::runtime_error ( "failed to open file!" );
-    }
-
-    size_t fileSize = ( size_t ) file.tellg ();
-    std::vector<char> buffer ( fileSize );
-
-    file.seekg ( 0 );
-    file.read ( buffer.data () , fileSize );
-    
-    file.close ();
-
-    return buffer;
-}
-
-/*!
- * SHADER READING FUNCTIONS - END
- * ****************************************************************
-*/
+    std::string benchmark;                                              // --bench <name>
+    JZvk::PresentPolicy presentPolicy = JZvk::PresentPolicy::LOW_LATENCY;   // --present <policy>
+    bool headless = false;                                              // --headless, no window or surface
+    uint32_t headlessFrames = 1000;                                     // --frames <n>, main loop length when headless
+    std::string capturePath;                                            // --capture <path>, reads back every frame
+    JZvk::CaptureFormat captureFormat = JZvk::CaptureFormat::RAW;       // --capture-format <raw|ppm|png>
+    uint32_t captureDepth = 2 * DEFAULT_FRAMES_IN_FLIGHT;               // --capture-depth <n>, readback ring slots
+    double dynamicResolutionMs = 0.0;                                   // --dynamic-resolution <ms>, gpu frame time target, off when 0
+    std::string device;                                                 // --device <index|name>, overrides JZVK_DEVICE and the score
+    std::string tracePath = "trace.json";                               // --trace <path>, chrome trace written at exit by JZVK_PROFILING builds
+    VkExtent2D resolution = { WIDTH , HEIGHT };                         // --resolution <w>x<h>, window or offscreen target size
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;                 // --frames-in-flight <n>, 1 to MAX_FRAMES_IN_FLIGHT
+    JZvk::Bench::SceneKind scene = JZvk::Bench::SceneKind::SINGLE;      // --scene <single|grid|scatter|overdraw>
+    uint32_t sceneSize = 1024;                                          // --scene-size <n>, objects of a generated scene
+    uint32_t warmupFrames = 100;                                        // --warmup <n>, unmeasured frames before --bench frames measures
+    std::string reportPath;                                             // --json <path>, --bench frames report, stdout when empty
+    bool objectRing = false;                                            // --object-ring, per object data through the dynamic uniform ring
+    VkDebugUtilsMessageSeverityFlagsEXT validationSeverities =          // --validation <verbose|info|warning|error>, lowest severity reported
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+};
 
 class HelloTriangleApplication
 {
 public:
-    void run()
+    void run( AppOptions const& options )
     {
+        presentPolicy = options.presentPolicy;
+        requestedPresentPolicy = options.presentPolicy;
+        headless = options.headless;
+        headlessFrames = options.headlessFrames;
+        capturePath = options.capturePath;
+        captureFormat = options.captureFormat;
+        captureDepth = options.captureDepth;
+        dynamicResolutionMs = options.dynamicResolutionMs;
+        pinnedDevice = options.device;
+        JZvk::GetValidationSink ().SetSeverities ( options.validationSeverities );
+        tracePath = options.tracePath;
+        targetExtent = options.resolution;
+        framesInFlight = options.framesInFlight;
+        sceneKind = options.scene;
+        sceneSize = options.sceneSize;
+        warmupFrames = options.warmupFrames;
+        reportPath = options.reportPath;
+        objectRing = options.objectRing;
+        JZVK_PROFILE_THREAD ( "main" );
+
         //initWindow();
-        window = JZvk::Create::GLFWWindow ( WIDTH , HEIGHT , "Vulkan" );
+        if ( !headless )
+        {
+            window = JZvk::Create::GLFWWindow ( targetExtent.width , targetExtent.height , "Vulkan" );
+            glfwSetWindowUserPointer ( window , this );
+            glfwSetFramebufferSizeCallback ( window , framebufferResizeCallback );
+            glfwSetKeyCallback ( window , keyCallback );
+        }
         initVulkan();
-        mainLoop();
+        if ( options.benchmark.empty () )
+        {
+            mainLoop ();
+        }
+        else
+        {
+            runBenchmark ( options.benchmark );
+        }
         cleanup();
+        writeTrace ();
     }
 
 private:
-    GLFWwindow* window;                                 // glfw created window instance
+    GLFWwindow* window = nullptr;                       // glfw created window instance, null when headless
+    bool headless = false;                              // offscreen targets instead of a window, surface and swap chain
+    uint32_t headlessFrames = 0;                        // frames the headless main loop renders
+    std::string capturePath;                            // frames are read back and written here when set
+    JZvk::CaptureFormat captureFormat;
+    uint32_t captureDepth = 0;
+    JZvk::FrameReadback frameReadback;                  // copies of presented or offscreen images, written on its own thread
+    double dynamicResolutionMs = 0.0;
+    JZvk::DynamicResolution dynamicResolution;          // scene rendered at a scale of the swap chain extent, then upscaled
+    JZvk::GpuProfiler gpuProfiler;                      // gpu time of the zones in recordCommandBuffer
+    JZvk::PipelineStatistics pipelineStatistics;        // shader invocation and sample counts of the passes in recordCommandBuffer
+    uint64_t gpuSubmitTicks[ MAX_FRAMES_IN_FLIGHT ] = {}; // cpu profiler ticks at each frame's submit, places its gpu zones in the trace
+    std::string tracePath;                              // chrome trace of the cpu profiler, see writeTrace
+    VkExtent2D targetExtent {};                         // requested window size, the offscreen targets' size when headless
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+    JZvk::Bench::SceneKind sceneKind = JZvk::Bench::SceneKind::SINGLE;  // objects of sceneObjects, see JZvk::Bench::GenerateScene
+    uint32_t sceneSize = 0;
+    uint32_t warmupFrames = 0;                          // --bench frames renders these before headlessFrames measured ones
+    std::string reportPath;                             // --bench frames JSON, stdout when empty
     VkInstance instance;                                // vulkan instance
     VkDebugUtilsMessengerEXT debugMessenger;            // vulkan debug messenger, needed for vulkan debugging
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;   // vulkan physical device, i.e. gpu handle
+    std::string pinnedDevice;                           // physical device named on the command line, empty to select by score
+    JZvk::DeviceContext deviceContext;                  // physical device, queue family and surface queries, made once
+    uint32_t selectionQueryCalls = 0;                   // JZvk::QueryCallCount () once the device was picked
+    JZvk::DeviceCapabilities deviceCapabilities;        // optional features enabled on the logical device
     VkDevice device;                                    // logical device to interface with the physical device
     VkQueue graphicsQueue;                              // handle to the queues created with the logical device
-    VkSurfaceKHR  surface;
+    VkSurfaceKHR  surface = VK_NULL_HANDLE;
     VkQueue presentQueue;
-    VkSwapchainKHR swapChain;
+    VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+    JZvk::OffscreenTargets offscreenTargets;            // swap chain images when headless
+    JZvk::PresentPolicy presentPolicy;                  // policy the swap chain was created with
+    JZvk::PresentPolicy requestedPresentPolicy;         // set from the keyboard, applied by drawFrame
+    VkPresentModeKHR presentMode;                       // mode presentPolicy resolved to on this surface
     std::vector<VkImage> swapChainImages;
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
     std::vector<VkImageView> swapChainImageViews;
     VkRenderPass renderPass;
+    JZvk::DescriptorLayoutCache descriptorLayouts;      // set layouts shared by every pipeline layout
+    JZvk::DescriptorAllocator descriptorAllocator;      // long lived descriptor sets
+    std::vector<JZvk::DescriptorAllocator> frameDescriptors;    // transient sets, reset when their frame retires
+    JZvk::BindlessTable bindlessTable;                  // set 0 when descriptor indexing is supported
+    JZvk::Buffer materialTint;                          // tint of the triangle material, read through bindlessTable by bindless.frag
+    uint32_t materialTintIndex = JZvk::BindlessTable::INVALID_INDEX;
+    JZvk::TransientBindings drawBindings;               // set 1, pushed when push descriptors are supported. no shader reads it yet
+    JZvk::UniformRing objectUniforms;                   // set 2, or push constants when they fit
+    std::vector<ObjectUniforms> sceneObjects;           // drawn every frame, written into objectUniforms
     VkPipelineLayout pipelineLayout;
+    VkPipelineCache pipelineCache;
+    VkShaderModule vertShaderModule;
+    VkShaderModule fragShaderModule;
+    JZvk::ShaderPermutations fragPermutations;          // material feature switches of shader.frag and bindless.frag
+    JZvk::PermutationPipelines pipelinePermutations;    // pipelines per permutation, built on first use
+    JZvk::PipelineLibrary pipelineLibrary;              // linked permutations, replaces pipelinePermutations when supported
+    JZvk::PermutationKey materialFeatures = 0;          // features enabled for the triangle material
+    VkBool32 objectPushConstants = VK_TRUE;             // OBJECT_PUSH_CONSTANTS of shader.vert
+    bool objectRing = false;                            // per object data through dynamic offsets even when it fits in push constants
+    VkSpecializationMapEntry objectSpecializationEntry { 0 , 0 , sizeof ( VkBool32 ) };
+    VkSpecializationInfo objectSpecialization { 1 , &objectSpecializationEntry , sizeof ( VkBool32 ) , &objectPushConstants };
     VkPipeline graphicsPipeline;
+    JZvk::DynamicState pipelineState;                   // viewport, scissor and raster state set per command buffer
     std::vector<VkFramebuffer> swapChainFramebuffers;
     VkCommandPool commandPool;
     std::vector<VkCommandBuffer> commandBuffers;
@@ -167,6 +293,61 @@ private:
     std::vector<VkFence> inFlightFences;
     std::vector<VkFence> imagesInFlight;
     size_t currentFrame = 0;
+    uint64_t frameNumber = 0;                           // frames submitted so far
+    bool framebufferResized = false;                    // set by glfw, the swap chain is recreated after the next present
+
+    // objects of a replaced swap chain, destroyed from drawFrame once no frame in flight can use them
+    struct RetiredSwapchain
+    {
+        VkSwapchainKHR swapChain;
+        std::vector<VkImageView> imageViews;
+        std::vector<VkFramebuffer> framebuffers;
+        uint64_t lastFrame;     // frames numbered below this may still reference them
+    };
+    std::vector<RetiredSwapchain> retiredSwapchains;
+
+    // frame time is measured between drawFrame calls, present interval between vkQueuePresentKHR returns
+    struct PresentStats
+    {
+        JZvk::Bench::Histogram frameTime;
+        JZvk::Bench::Histogram presentInterval;
+    };
+    std::map<VkPresentModeKHR , PresentStats> presentStats;
+    std::optional<std::chrono::steady_clock::time_point> lastFrameStart;
+    std::optional<std::chrono::steady_clock::time_point> lastPresent;
+
+    static void keyCallback ( GLFWwindow* keyWindow , int key , int scancode , int action , int mods )
+    {
+        UNRERENCED_PARAMETER ( scancode );
+        UNRERENCED_PARAMETER ( mods );
+        if ( action != GLFW_PRESS )
+        {
+            return;
+        }
+        auto app = reinterpret_cast< HelloTriangleApplication* >( glfwGetWindowUserPointer ( keyWindow ) );
+
+        // 1 to 4 select a present policy in PresentPolicy order, H prints the histograms so far, T writes the trace so far
+        if ( key >= GLFW_KEY_1 && key < GLFW_KEY_1 + static_cast< int >( JZvk::PresentPolicy::COUNT ) )
+        {
+            app->requestedPresentPolicy = static_cast< JZvk::PresentPolicy >( key - GLFW_KEY_1 );
+        }
+        else if ( key == GLFW_KEY_H )
+        {
+            app->reportPresentStats ();
+        }
+        else if ( key == GLFW_KEY_T )
+        {
+            app->writeTrace ();
+        }
+    }
+
+    static void framebufferResizeCallback ( GLFWwindow* resizedWindow , int width , int height )
+    {
+        UNRERENCED_PARAMETER ( width );
+        UNRERENCED_PARAMETER ( height );
+        auto app = reinterpret_cast< HelloTriangleApplication* >( glfwGetWindowUserPointer ( resizedWindow ) );
+        app->framebufferResized = true;
+    }
 
     // vulkan sdk validation layers
     const std::vector<const char*> validationLayers = {
@@ -308,40 +489,410 @@ private:
     const bool enableValidationLayers = true;
     #endif
 
+    // steps that do not depend on each other run side by side, e.g. shader modules and the pipeline
+    // cache are created while the swap chain is built. glfw is only touched from the main thread.
+    // steps sharing the descriptor layout cache or allocator are chained, neither is thread safe
     void initVulkan()
     {
-        //createInstance();
-        instance                = JZvk::Create::VKInstance ( "Vulkan" );
-        debugMessenger          = JZvk::Create::VKDebugMessenger ( instance );
-        //setupDebugMessenger();
-        //createSurface ();
-        surface                 = JZvk::Create::VKSurface ( instance , window );
-        //pickPhysicalDevice();
-        physicalDevice          = JZvk::Create::VKPhysicalDevice ( instance , surface );
-        //createLogicalDevice ();
-        device                  = JZvk::Create::VKLogicalDevice ( physicalDevice , surface );
-        graphicsQueue           = JZvk::Create::VKGraphicsQueue ( device , physicalDevice , surface );
-        presentQueue            = JZvk::Create::VKGraphicsQueue ( device , physicalDevice , surface );
+        JZVK_PROFILE_FUNCTION ();
+        using Thread = JZvk::StartupGraph::Thread;
+        JZvk::StartupGraph startup;
+
+        auto const instanceStep = startup.Add ( "instance" , [ this ] ()
+        {
+            //createInstance();
+            instance                = JZvk::Create::VKInstance ( "Vulkan" , true , !headless );
+            //setupDebugMessenger();
+            debugMessenger          = JZvk::Create::VKDebugMessenger ( instance );
+        } , {} , Thread::MAIN );
+
+        // maps the archive, only file i/o and nothing vulkan
+        auto const archiveStep = startup.Add ( "shader archive" , [] ()
+        {
+            JZvk::Shader::Find ( "shader.vert" );
+        } );
+
+        auto const surfaceStep = startup.Add ( "surface" , [ this ] ()
+        {
+            //createSurface ();
+            if ( !headless )
+            {
+                surface             = JZvk::Create::VKSurface ( instance , window );
+            }
+        } , { instanceStep } , Thread::MAIN );
+
+        auto const deviceStep = startup.Add ( "device" , [ this ] ()
+        {
+            //pickPhysicalDevice();
+            physicalDevice          = JZvk::Create::VKPhysicalDevice ( instance , surface , pinnedDevice.c_str () );
+            selectionQueryCalls     = JZvk::QueryCallCount ();
+            deviceContext           = JZvk::GetDeviceContext ( physicalDevice , surface );
+            deviceCapabilities      = deviceContext.capabilities_;
+            //createLogicalDevice ();
+            device                  = JZvk::Create::VKLogicalDevice ( deviceContext );
+            JZvk::LoadDeviceDispatch ( device );
+            JZvk::LoadDynamicStateFunctions ( device , deviceCapabilities );
+            graphicsQueue           = JZvk::Create::VKGraphicsQueue ( device , deviceContext );
+        } , { surfaceStep } );
+
+        auto const descriptorStep = startup.Add ( "descriptors" , [ this ] ()
+        {
+            createDescriptorAllocators ();
+        } , { deviceStep } );
+
+        auto const swapChainStep = startup.Add ( "swap chain" , [ this ] ()
+        {
+            if ( headless )
+            {
+                createOffscreenTargets ();
+            }
+            else
+            {
+                createSwapChainTargets ();
+            }
+            pipelineState.SetExtent ( swapChainExtent );
+        } , { deviceStep } , Thread::MAIN );
+
+        auto const shaderStep = startup.Add ( "shader modules" , [ this ] ()
+        {
+            createShaderModules ();
+        } , { archiveStep , descriptorStep } );
+
+        auto const cacheStep = startup.Add ( "pipeline cache" , [ this ] ()
+        {
+            pipelineCache = JZvk::Create::VKPipelineCache ( device , physicalDevice , PIPELINE_CACHE_FILE );
+        } , { deviceStep } );
+
+        auto const commandStep = startup.Add ( "command buffers" , [ this ] ()
+        {
+            createCommandPool ();
+            createCommandBuffers ();
+        } , { deviceStep } );
+
+        auto const renderPassStep = startup.Add ( "render pass" , [ this ] ()
+        {
+            createRenderPass ();
+        } , { swapChainStep } );
+
+        auto const pipelineStep = startup.Add ( "pipelines" , [ this ] ()
+        {
+            createGraphicsPipeline ();
+        } , { descriptorStep , shaderStep , cacheStep , renderPassStep } );
+
+        auto const framebufferStep = startup.Add ( "framebuffers" , [ this ] ()
+        {
+            createFramebuffers ();
+        } , { renderPassStep } );
+
+        auto const profilerStep = startup.Add ( "gpu profiler" , [ this ] ()
+        {
+            gpuProfiler.Initialize ( device , deviceContext , framesInFlight );
+            pipelineStatistics.Initialize ( device , deviceContext , framesInFlight );
+        } , { deviceStep } );
+
+        startup.Add ( "dynamic resolution" , [ this ] ()
+        {
+            createDynamicResolution ();
+        } , { pipelineStep , framebufferStep , profilerStep } );
+
+        startup.Add ( "sync objects" , [ this ] ()
+        {
+            createSyncObjects ();
+        } , { swapChainStep , commandStep } );
+
+        startup.Add ( "frame readback" , [ this ] ()
+        {
+            createFrameReadback ();
+        } , { swapChainStep } );
+
+        startup.Run ();
+        // the report is printed directly, let the steps' log output go first
+        JZvk::FlushLog ();
+        startup.Report ();
+
+        // measured against what the Create:: functions queried on their own before the device context
+        JZvk::PerCallQueryCount const perCall = JZvk::GetPerCallQueryCount ( deviceContext , dynamicResolution.Enabled () , frameReadback.Enabled () );
+        JZvk::Log ( JZvk::LOG::INFO , "STARTUP QUERIES" );
+        JZvk::Log ( JZvk::LOG::INFO , "\t" , JZvk::QueryCallCount () , " physical device, queue family and surface query calls, " , selectionQueryCalls , " of them selecting the device" );
+        JZvk::Log ( JZvk::LOG::INFO , "\t" , JZvk::QueryCallCount () - selectionQueryCalls , " after device selection, " , perCall.startup_ , " when every Create:: function queried its own" );
+        JZvk::FlushLog ();
+    }
+
+    void createDynamicResolution ()
+    {
+        if ( dynamicResolutionMs <= 0.0 )
+        {
+            return;
+        }
+        // renders at full resolution without it
+        dynamicResolution.Initialize ( device , deviceContext , gpuProfiler , descriptorLayouts , descriptorAllocator , pipelineCache , renderPass , swapChainImageFormat , swapChainExtent ,
+                                       framesInFlight , JZvk::Shader::Find ( "upscale.vert" ) , JZvk::Shader::Find ( "upscale.frag" ) ,
+                                       dynamicResolutionMs );
+    }
+
+    void createFrameReadback ()
+    {
+        if ( capturePath.empty () )
+        {
+            return;
+        }
+        if ( !headless && !( deviceContext.swapchain_support_.capabilities_.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT ) )
+        {
+            throw std::runtime_error ( "swap chain images of this surface cannot be read back!" );
+        }
+        // deeper than the frames in flight, or every frame waiting on the writer would be dropped
+        if ( !frameReadback.Initialize ( device , physicalDevice , swapChainExtent , swapChainImageFormat ,
+                                         std::max ( captureDepth , framesInFlight ) , capturePath , captureFormat ) )
+        {
+            throw std::runtime_error ( "failed to create frame readback!" );
+        }
+    }
+
+    void createSwapChainTargets ()
+    {
+        presentQueue            = JZvk::Create::VKPresentQueue ( device , deviceContext );
         //createSwapChain ();
-        swapChain               = JZvk::Create::VKSwapchain ( window , device , physicalDevice , surface );
-        swapChainExtent         = JZvk::Create::VKSwapchainExtent2D ( window , physicalDevice , surface );
-        swapChainImageFormat    = JZvk::Create::VKSwapchainSurfaceFormat ( physicalDevice , surface ).format;
+        swapChain               = JZvk::Create::VKSwapchain ( window , device , deviceContext , VK_NULL_HANDLE , presentPolicy );
+        presentMode             = JZvk::Create::VKSwapchainPresentMode ( deviceContext , presentPolicy );
+        JZvk::Log ( JZvk::LOG::INFO , "PRESENT MODE" );
+        JZvk::Log ( JZvk::LOG::INFO , "\t" , JZvk::PresentPolicyName ( presentPolicy ) , " policy, " , JZvk::PresentModeName ( presentMode ) );
+        swapChainExtent         = JZvk::Create::VKSwapchainExtent2D ( window , deviceContext );
+        swapChainImageFormat    = JZvk::Create::VKSwapchainSurfaceFormat ( deviceContext ).format;
         swapChainImages         = JZvk::Create::VKSwapchainImages ( device , swapChain );
         //createImageViews ();
         swapChainImageViews = JZvk::Create::VKSwapchainImageViews ( device , swapChainImages , swapChainImageFormat );
-        createRenderPass ();
-        createGraphicsPipeline ();
+    }
+
+    // headless stand in for the swap chain, one image per frame in flight in the format a surface
+    // would most likely offer, so the render pass and pipelines are the same as when presenting
+    void createOffscreenTargets ()
+    {
+        swapChainExtent         = targetExtent;
+        swapChainImageFormat    = VK_FORMAT_B8G8R8A8_SRGB;
+        if ( !offscreenTargets.Initialize ( device , physicalDevice , swapChainExtent , swapChainImageFormat , framesInFlight ) )
+        {
+            throw std::runtime_error ( "failed to create offscreen targets!" );
+        }
+        swapChainImages         = offscreenTargets.Images ();
+        swapChainImageViews     = JZvk::Create::VKSwapchainImageViews ( device , swapChainImages , swapChainImageFormat );
+
+        // nothing paces offscreen frames, statistics are filed under the closest present mode
+        presentMode             = VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+
+    // incremental recreate for a resized or out of date surface, only what depends on the swap chain
+    // images is rebuilt. command buffers are recorded per frame and pick up the new extent on their own
+    void recreateSwapChain ()
+    {
+        // a minimized window has no drawable area, block on events until it is restored instead of spinning
+        int width = 0 , height = 0;
+        glfwGetFramebufferSize ( window , &width , &height );
+        while ( ( width == 0 || height == 0 ) && !glfwWindowShouldClose ( window ) )
+        {
+            glfwWaitEvents ();
+            glfwGetFramebufferSize ( window , &width , &height );
+        }
+        if ( width == 0 || height == 0 )
+        {
+            return;
+        }
+        framebufferResized = false;
+
+        // frames in flight may still render to the old images, so they are retired rather than waited on
+        retiredSwapchains.push_back ( { swapChain , std::move ( swapChainImageViews ) , std::move ( swapChainFramebuffers ) , frameNumber } );
+
+        // only the current extent changed, formats and present modes are those of the same surface,
+        // so the render pass and every pipeline still match
+        uint32_t const queryCalls = JZvk::QueryCallCount ();
+        JZvk::RefreshSurfaceCapabilities ( deviceContext );
+        swapChain               = JZvk::Create::VKSwapchain ( window , device , deviceContext , retiredSwapchains.back ().swapChain , presentPolicy );
+        presentMode             = JZvk::Create::VKSwapchainPresentMode ( deviceContext , presentPolicy );
+        swapChainExtent         = JZvk::Create::VKSwapchainExtent2D ( window , deviceContext );
+        JZvk::Log ( JZvk::LOG::INFO , "SWAP CHAIN RECREATE" );
+        JZvk::Log ( JZvk::LOG::INFO , "\t" , JZvk::QueryCallCount () - queryCalls , " surface query calls, " ,
+                    JZvk::GetPerCallQueryCount ( deviceContext , false , false ).recreate_ , " when every Create:: function queried its own" );
+        swapChainImages         = JZvk::Create::VKSwapchainImages ( device , swapChain );
+
+        swapChainImageViews     = JZvk::Create::VKSwapchainImageViews ( device , swapChainImages , swapChainImageFormat );
+        pipelineState.SetExtent ( swapChainExtent );
         createFramebuffers ();
-        createCommandPool ();
-        createCommandBuffers ();
-        createSyncObjects ();
+
+        // a smaller window renders into the top left of the same targets, only growing past them reallocates
+        if ( dynamicResolution.Enabled () )
+        {
+            if ( !dynamicResolution.Fits ( swapChainExtent ) )
+            {
+                vkDeviceWaitIdle ( device );
+            }
+            if ( !dynamicResolution.Resize ( swapChainExtent ) )
+            {
+                throw std::runtime_error ( "failed to resize dynamic resolution targets!" );
+            }
+        }
+
+        // the readback ring is sized for the first extent, recordCommandBuffer skips capturing until it matches again
+        VkExtent2D const captureExtent = frameReadback.Extent ();
+        if ( frameReadback.Enabled () && ( captureExtent.width != swapChainExtent.width || captureExtent.height != swapChainExtent.height ) )
+        {
+            JZvk::Log ( JZvk::LOG::ERROR , "Frame capture paused, the swap chain is " , swapChainExtent.width , "x" , swapChainExtent.height ,
+                        " and captures are " , captureExtent.width , "x" , captureExtent.height , "." );
+        }
+
+        // no frame has used the new images yet
+        imagesInFlight.assign ( swapChainImages.size () , VK_NULL_HANDLE );
+    }
+
+    // the present mode is fixed at swap chain creation, so a new policy means a new swap chain
+    void switchPresentPolicy ()
+    {
+        presentPolicy = requestedPresentPolicy;
+        recreateSwapChain ();
+        JZvk::Log ( JZvk::LOG::INFO , "PRESENT MODE" );
+        JZvk::Log ( JZvk::LOG::INFO , "\t" , JZvk::PresentPolicyName ( presentPolicy ) , " policy, " , JZvk::PresentModeName ( presentMode ) );
+
+        // the frame spanning the switch belongs to neither mode
+        lastFrameStart.reset ();
+        lastPresent.reset ();
+    }
+
+    // cpu zones of every thread and the gpu zones of recent frames, nothing without JZVK_PROFILING
+    void writeTrace ()
+    {
+        if ( !JZvk::Profiler::Enabled () || tracePath.empty () )
+        {
+            return;
+        }
+        JZvk::Profiler::WriteTrace ( tracePath );
+        JZvk::FlushLog ();
+    }
+
+    void reportPresentStats ()
+    {
+        JZvk::FlushLog ();
+        for ( auto const& stats : presentStats )
+        {
+            std::string const mode = headless ? "headless" : JZvk::PresentModeName ( stats.first );
+            stats.second.frameTime.Print ( mode + " frame time" );
+            // headless frames are never presented
+            if ( stats.second.presentInterval.Count () > 0 )
+            {
+                stats.second.presentInterval.Print ( mode + " present interval" );
+            }
+        }
+        if ( dynamicResolution.Enabled () )
+        {
+            JZvk::ResolutionController const& controller = dynamicResolution.Controller ();
+            std::cout << "dynamic resolution: scale " << controller.Scale () << ", " << controller.SmoothedMs () << " ms gpu" << std::endl;
+        }
+        if ( gpuProfiler.Enabled () )
+        {
+            gpuProfiler.Metrics ().Print ( "gpu zones, ms per frame over the rolling window" );
+        }
+        if ( pipelineStatistics.Enabled () )
+        {
+            pipelineStatistics.Metrics ().Print ( pipelineStatistics.PreciseOcclusion () ? "pipeline statistics, counts per pass over the rolling window" :
+                                                  "pipeline statistics, counts per pass over the rolling window, no overdraw without occlusionQueryPrecise" );
+        }
+    }
+
+    // destroys retired swap chains no longer referenced by a frame in flight, or all of them once the device is idle
+    void destroyRetiredSwapchains ( bool all )
+    {
+        for ( auto it = retiredSwapchains.begin (); it != retiredSwapchains.end (); )
+        {
+            // after the fence wait in drawFrame, every frame up to frameNumber - framesInFlight has completed
+            if ( !all && it->lastFrame + framesInFlight > frameNumber + 1 )
+            {
+                ++it;
+                continue;
+            }
+
+            for ( auto framebuffer : it->framebuffers )
+            {
+                vkDestroyFramebuffer ( device , framebuffer , nullptr );
+            }
+            for ( auto imageView : it->imageViews )
+            {
+                vkDestroyImageView ( device , imageView , nullptr );
+            }
+            vkDestroySwapchainKHR ( device , it->swapChain , nullptr );
+            it = retiredSwapchains.erase ( it );
+        }
+    }
+
+    void createDescriptorAllocators ()
+    {
+        descriptorLayouts.Initialize ( device );
+        descriptorAllocator.Initialize ( device );
+
+        frameDescriptors.resize ( framesInFlight );
+        for ( auto& allocator : frameDescriptors )
+        {
+            allocator.Initialize ( device );
+        }
+
+        // optional, materials fall back to per draw bindings without it
+        if ( bindlessTable.Initialize ( device , deviceCapabilities , descriptorLayouts ) )
+        {
+            createMaterialTint ();
+        }
+
+        drawBindings.Initialize ( device , deviceCapabilities , descriptorLayouts , drawBindingLayout () );
+
+        // SINGLE is the one triangle drawn before generated scenes, same for the same size on every run
+        for ( auto const& transform : JZvk::Bench::GenerateScene ( sceneKind , sceneSize ) )
+        {
+            ObjectUniforms object;
+            std::copy ( transform.begin () , transform.end () , object.transform );
+            sceneObjects.push_back ( object );
+        }
+
+        uint32_t const maxObjects = std::max ( MAX_OBJECTS_PER_FRAME , static_cast< uint32_t >( sceneObjects.size () ) );
+        if ( !objectUniforms.Initialize ( device , physicalDevice , descriptorLayouts , descriptorAllocator ,
+                                          framesInFlight , sizeof ( ObjectUniforms ) , maxObjects ,
+                                          VK_SHADER_STAGE_VERTEX_BIT , OBJECT_PUSH_OFFSET , !objectRing ) )
+        {
+            throw std::runtime_error ( "failed to create object uniform ring!" );
+        }
+        objectPushConstants = objectUniforms.PushesConstants () ? VK_TRUE : VK_FALSE;
+    }
+
+    // the triangle material's tint, a vec4 in a storage buffer that bindless.frag fetches by its index in the table
+    void createMaterialTint ()
+    {
+        float const tint[ 4 ] = { 1.0f , 0.85f , 0.7f , 1.0f };
+        materialTint = JZvk::Create::VKBuffer ( device , physicalDevice , sizeof ( tint ) , VK_BUFFER_USAGE_STORAGE_BUFFER_BIT ,
+                                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+        if ( !materialTint.mapped_ )
+        {
+            throw std::runtime_error ( "failed to create material tint buffer!" );
+        }
+        std::memcpy ( materialTint.mapped_ , tint , sizeof ( tint ) );
+        materialTintIndex = bindlessTable.AddBuffer ( materialTint.buffer_ );
+    }
+
+    // per draw uniform data at binding 0 of DRAW_SET, written by the pushdescriptors benchmark.
+    // the scene's per object data goes through objectUniforms instead
+    std::vector<VkDescriptorSetLayoutBinding> drawBindingLayout ()
+    {
+        return {
+            { 0 , VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER , 1 , VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT , nullptr }
+        };
+    }
+
+    // template data for DRAW_SET is a single VkDescriptorBufferInfo
+    std::vector<VkDescriptorUpdateTemplateEntry> drawBindingEntries ()
+    {
+        return {
+            { 0 , 0 , 1 , VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER , 0 , sizeof ( VkDescriptorBufferInfo ) }
+        };
     }
 
     void createSyncObjects ()
     {
-        imageAvailableSemaphores.resize ( MAX_FRAMES_IN_FLIGHT );
-        renderFinishedSemaphores.resize ( MAX_FRAMES_IN_FLIGHT );
-        inFlightFences.resize ( MAX_FRAMES_IN_FLIGHT );
+        imageAvailableSemaphores.resize ( framesInFlight );
+        renderFinishedSemaphores.resize ( framesInFlight );
+        inFlightFences.resize ( framesInFlight );
         imagesInFlight.resize ( swapChainImages.size () , VK_NULL_HANDLE );
 
         VkSemaphoreCreateInfo semaphoreInfo {};
@@ -351,7 +902,7 @@ private:
         fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-        for ( size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
+        for ( size_t i = 0; i < framesInFlight; ++i )
         {
             if ( vkCreateSemaphore ( device , &semaphoreInfo , nullptr , &imageAvailableSemaphores[i] ) != VK_SUCCESS ||
                 vkCreateSemaphore ( device , &semaphoreInfo , nullptr , &renderFinishedSemaphores[i] ) != VK_SUCCESS ||
@@ -364,7 +915,8 @@ private:
 
     void createCommandBuffers ()
     {
-        commandBuffers.resize ( swapChainFramebuffers.size () );
+        // one per frame in flight, recorded every frame since per object data moves through the ring
+        commandBuffers.resize ( framesInFlight );
 
         VkCommandBufferAllocateInfo allocInfo {};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -376,36 +928,83 @@ private:
         {
             throw std::runtime_error ( "failed to allocate command buffers!" );
         }
+    }
+
+    void recordCommandBuffer ( VkCommandBuffer commandBuffer , uint32_t imageIndex )
+    {
+        JZVK_PROFILE_FUNCTION ();
+
+        // begin command buffer
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = nullptr;
 
-        for ( size_t i = 0; i < commandBuffers.size (); ++i )
+        if ( JZvk::Dispatch ().BeginCommandBuffer ( commandBuffer , &beginInfo ) != VK_SUCCESS )
         {
-            // begin command buffer
-            VkCommandBufferBeginInfo beginInfo {};
-            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-            beginInfo.flags = 0;
-            beginInfo.pInheritanceInfo = nullptr;
+            throw std::runtime_error ( "failed to begin recording command buffer!" );
+        }
 
-            if ( vkBeginCommandBuffer ( commandBuffers[ i ] , &beginInfo ) != VK_SUCCESS )
-            {
-                throw std::runtime_error ( "failed to begin recording command buffer!" );
-            }
+        gpuProfiler.BeginFrame ( commandBuffer , static_cast< uint32_t >( currentFrame ) );
+        uint32_t const frameZone = gpuProfiler.BeginZone ( commandBuffer , "frame" );
+        pipelineStatistics.BeginFrame ( commandBuffer , static_cast< uint32_t >( currentFrame ) );
+
+        // assign render pass to command buffer and begin render pass
+        VkRenderPassBeginInfo renderPassInfo {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = swapChainFramebuffers[ imageIndex ];
+        renderPassInfo.renderArea.offset = { 0,0 };
+        renderPassInfo.renderArea.extent = swapChainExtent;
+
+        VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearColor;
+
+        // with dynamic resolution the scene goes to an offscreen target at the controller's scale instead
+        JZvk::DynamicState sceneState = pipelineState;
+        uint32_t const sceneZone = gpuProfiler.BeginZone ( commandBuffer , "scene" );
+        uint32_t const scenePass = pipelineStatistics.Begin ( commandBuffer , "scene" );
+        if ( dynamicResolution.Enabled () )
+        {
+            sceneState.SetExtent ( dynamicResolution.BeginScene ( commandBuffer , static_cast< uint32_t >( currentFrame ) , clearColor ) );
+        }
+        else
+        {
+            JZvk::Dispatch ().CmdBeginRenderPass ( commandBuffer , &renderPassInfo , VK_SUBPASS_CONTENTS_INLINE );
+        }
 
-            // assign render pass to command buffer and begin render pass
-            VkRenderPassBeginInfo renderPassInfo {};
-            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-            renderPassInfo.renderPass = renderPass;
-            renderPassInfo.framebuffer = swapChainFramebuffers[ i ];
-            renderPassInfo.renderArea.offset = { 0,0 };
-            renderPassInfo.renderArea.extent = swapChainExtent;
+        // linked pipelines are swapped for their optimized link once the background compile is done
+        // null only if the permutation failed to build every way, the previous pipeline stays bound then
+        if ( pipelineLibrary.Enabled () )
+        {
+            VkPipeline const linked = pipelineLibrary.Get ( materialFeatures );
+            graphicsPipeline = linked != VK_NULL_HANDLE ? linked : graphicsPipeline;
+        }
+
+        // bind graphics pipeline
+        JZvk::Dispatch ().CmdBindPipeline ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , graphicsPipeline );
+
+        // viewport, scissor and raster state are not baked into the pipeline
+        JZvk::CmdSetDynamicState ( commandBuffer , sceneState );
 
-            VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
-            renderPassInfo.clearValueCount = 1;
-            renderPassInfo.pClearValues = &clearColor;
+        // bound once, every draw indexes into it
+        if ( bindlessTable.Enabled () )
+        {
+            bindlessTable.Bind ( commandBuffer , pipelineLayout , BINDLESS_SET );
+        }
 
-            vkCmdBeginRenderPass ( commandBuffers[ i ] , &renderPassInfo , VK_SUBPASS_CONTENTS_INLINE );
+        // feature flags for runtime branching permutations, ignored by specialized ones
+        MaterialConstants material { materialFeatures , JZvk::BindlessTable::INVALID_INDEX , materialTintIndex };
+        JZvk::Dispatch ().CmdPushConstants ( commandBuffer , pipelineLayout , VK_SHADER_STAGE_FRAGMENT_BIT , 0 , sizeof ( material ) , &material );
 
-            // bind graphics pipeline
-            vkCmdBindPipeline ( commandBuffers[ i ] , VK_PIPELINE_BIND_POINT_GRAPHICS , graphicsPipeline );
+        for ( auto const& object : sceneObjects )
+        {
+            // pushed, or a slice of this frame's uniform buffer selected by dynamic offset
+            if ( !objectUniforms.Bind ( commandBuffer , pipelineLayout , OBJECT_SET , &object ) )
+            {
+                break;
+            }
 
             // bind draw command
             // param
@@ -413,28 +1012,49 @@ private:
             // 2. vertex count
             // 3. first vertex
             // 4. first instance
-            vkCmdDraw ( commandBuffers[ i ] , 3 , 1 , 0 , 0 );
+            JZvk::Dispatch ().CmdDraw ( commandBuffer , 3 , 1 , 0 , 0 );
+        }
 
-            // end render pass
-            vkCmdEndRenderPass ( commandBuffers[ i ] );
+        // end render pass
+        JZvk::Dispatch ().CmdEndRenderPass ( commandBuffer );
+        pipelineStatistics.End ( commandBuffer , scenePass );
+        gpuProfiler.EndZone ( commandBuffer , sceneZone );
 
-            // end command buffer
-            if ( vkEndCommandBuffer ( commandBuffers[ i ] ) != VK_SUCCESS )
-            {
-                throw std::runtime_error ( "failed to record command buffer!" );
-            }
+        if ( dynamicResolution.Enabled () )
+        {
+            JZvk::GpuZone upscaleZone ( gpuProfiler , commandBuffer , "upscale" );
+            uint32_t const upscalePass = pipelineStatistics.Begin ( commandBuffer , "upscale" );
+            dynamicResolution.Upscale ( commandBuffer , static_cast< uint32_t >( currentFrame ) , swapChainFramebuffers[ imageIndex ] );
+            pipelineStatistics.End ( commandBuffer , upscalePass );
+        }
+
+        // copied out after the fence, see drawFrame. a resized swap chain no longer matches the readback buffers
+        VkExtent2D const captureExtent = frameReadback.Extent ();
+        if ( frameReadback.Enabled () && captureExtent.width == swapChainExtent.width && captureExtent.height == swapChainExtent.height )
+        {
+            JZvk::GpuZone readbackZone ( gpuProfiler , commandBuffer , "readback" );
+            frameReadback.Capture ( commandBuffer , swapChainImages[ imageIndex ] ,
+                                    headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR , static_cast< uint32_t >( currentFrame ) );
+        }
+
+        gpuProfiler.EndZone ( commandBuffer , frameZone );
+
+        // end command buffer
+        if ( JZvk::Dispatch ().EndCommandBuffer ( commandBuffer ) != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to record command buffer!" );
         }
     }
 
     // command pool stores draw commands
     void createCommandPool ()
     {
-        QueueFamilyIndices queueFamilyIndices = findQueueFamilies ( physicalDevice );
+        JZvk::QueueFamilyIndices const& queueFamilyIndices = deviceContext.queue_family_indices_;
         
         VkCommandPoolCreateInfo poolInfo {};
         poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value ();
-        poolInfo.flags = 0;
+        poolInfo.queueFamilyIndex = queueFamilyIndices.graphics_family_.value ();
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
         if ( vkCreateCommandPool ( device , &poolInfo , nullptr , &commandPool ) != VK_SUCCESS )
         {
@@ -480,7 +1100,8 @@ private:
         colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        // offscreen targets are only ever copied from, and PRESENT_SRC_KHR needs the swap chain extension
+        colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
         // subpasses and attachment references, for postprocessing
         VkAttachmentReference colorAttachmentRef {};
@@ -516,12 +1137,13 @@ private:
         }
     }
 
-    VkShaderModule createShaderModule ( std::vector<char> const& code )
+    VkShaderModule createShaderModule ( JZvk::SPIRVView code )
     {
+        // reads straight from the archive mapping
         VkShaderModuleCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = code.size ();
-        createInfo.pCode = reinterpret_cast< uint32_t const* >( code.data () );
+        createInfo.codeSize = code.size_;
+        createInfo.pCode = code.code_;
 
         VkShaderModule shaderModule;
         if ( vkCreateShaderModule ( device , &createInfo , nullptr , &shaderModule ) != VK_SUCCESS )
@@ -532,16 +1154,110 @@ private:
         return shaderModule;
     }
 
+    void createShaderModules ()
+    {
+        // compiled modules come from the shader archive, see shaders/compile
+        JZvk::SPIRVView vertShaderCode = JZvk::Shader::Find ( "shader.vert" );
+        // bindless.frag reads set 0, which only holds the table when descriptor indexing is supported
+        JZvk::SPIRVView fragShaderCode = JZvk::Shader::Find ( bindlessTable.Enabled () ? "bindless.frag" : "shader.frag" );
+
+        if ( vertShaderCode.Empty () || fragShaderCode.Empty () )
+        {
+            throw std::runtime_error ( "failed to load shaders from archive!" );
+        }
+
+        std::cout << "size of vert read : " << vertShaderCode.size_ << std::endl;
+        std::cout << "size of frag read : " << fragShaderCode.size_ << std::endl;
+
+        // modules stay alive for as long as permutations can still be built from them
+        vertShaderModule = createShaderModule ( vertShaderCode );
+        fragShaderModule = createShaderModule ( fragShaderCode );
+    }
+
+    // after createShaderModules and with the pipeline cache created
     void createGraphicsPipeline ()
     {
-        auto vertShaderCode = readFile ( "shaders/vert.spv" );
-        auto fragShaderCode = readFile ( "shaders/frag.spv" );
+        pipelineLayout = createPipelineLayout ( drawBindings.Layout () );
+        if ( !drawBindings.Finalize ( pipelineLayout , DRAW_SET , drawBindingEntries () ) )
+        {
+            throw std::runtime_error ( "failed to create draw binding update template!" );
+        }
+
+        // feature switches of material.glsl, constant ids match its layout(constant_id) declarations
+        fragPermutations.DeclareSpecializedSwitch ( 0 );
+        fragPermutations.DeclareFeature ( "FEATURE_PATTERN" , 1 );
+        fragPermutations.DeclareFeature ( "FEATURE_GRADING" , 2 );
+        materialFeatures = fragPermutations.FeatureBit ( "FEATURE_GRADING" );
+
+        pipelinePermutations.Initialize ( device , pipelineCache , &fragPermutations ,
+                                          [ this ] ( VkSpecializationInfo const* specialization , VkPipelineCache cache )
+                                          {
+                                              return buildGraphicsPipeline ( specialization , cache );
+                                          } );
+
+        // stage libraries linked per permutation, monolithic pipelines above without the extension
+        pipelineLibrary.Initialize ( device , deviceCapabilities , pipelineCache , pipelineLayout , &fragPermutations ,
+                                     [ this ] ( VkSpecializationInfo const* specialization , VkPipelineCache cache , VkGraphicsPipelineLibraryFlagsEXT parts )
+                                     {
+                                         // the library falls back on a null handle instead of unwinding
+                                         try
+                                         {
+                                             return buildGraphicsPipeline ( specialization , cache , parts );
+                                         }
+                                         catch ( std::runtime_error const& )
+                                         {
+                                             return VkPipeline { VK_NULL_HANDLE };
+                                         }
+                                     } );
+
+        graphicsPipeline = pipelineLibrary.Enabled () ? pipelineLibrary.Get ( materialFeatures ) : pipelinePermutations.Get ( materialFeatures );
+        if ( graphicsPipeline == VK_NULL_HANDLE )
+        {
+            throw std::runtime_error ( "failed to create graphics pipeline!" );
+        }
+    }
+
+    // uniform variables in shaders, pipeline layout
+    VkPipelineLayout createPipelineLayout ( VkDescriptorSetLayout drawSetLayout )
+    {
+        // push constant carries the feature flags read by runtime branching permutations,
+        // and the bindless resource indices of the material
+        VkPushConstantRange materialRange {};
+        materialRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        materialRange.offset = 0;
+        materialRange.size = sizeof ( MaterialConstants );
+
+        // per object data follows it in the vertex stage. shader.vert declares the block whichever way the
+        // ring binds it, so the range stays unless it is past maxPushConstantsSize, where it has zero size
+        VkPushConstantRange const objectRange = objectUniforms.PushRange ();
+        VkPushConstantRange pushRanges[] = { materialRange , objectRange };
+
+        // set numbers stay fixed, an empty layout stands in for a disabled bindless table
+        VkDescriptorSetLayout setLayouts[ 3 ];
+        setLayouts[ BINDLESS_SET ] = bindlessTable.Enabled () ? bindlessTable.Layout () : descriptorLayouts.Get ( {} );
+        setLayouts[ DRAW_SET ] = drawSetLayout;
+        setLayouts[ OBJECT_SET ] = objectUniforms.Layout ();
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo {};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 3;
+        pipelineLayoutInfo.pSetLayouts = setLayouts;
+        pipelineLayoutInfo.pushConstantRangeCount = objectRange.size > 0 ? 2 : 1;
+        pipelineLayoutInfo.pPushConstantRanges = pushRanges;
 
-        std::cout << "size of vert read : " << vertShaderCode.size () << std::endl;
-        std::cout << "size of frag read : " << fragShaderCode.size () << std::endl;
+        VkPipelineLayout layout;
+        if ( vkCreatePipelineLayout ( device , &pipelineLayoutInfo , nullptr , &layout ) != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to create pipeline layout!" );
+        }
+        return layout;
+    }
 
-        VkShaderModule vertShaderModule = createShaderModule ( vertShaderCode );
-        VkShaderModule fragShaderModule = createShaderModule ( fragShaderCode );
+    // builds one permutation of the graphics pipeline, specialization applies to the fragment stage.
+    // with libraryParts only those parts are compiled, as a library for JZvk::PipelineLibrary to link
+    VkPipeline buildGraphicsPipeline ( VkSpecializationInfo const* fragSpecialization , VkPipelineCache cache ,
+                                       VkGraphicsPipelineLibraryFlagsEXT libraryParts = 0 )
+    {
 
         // vertex shader stage creation
         VkPipelineShaderStageCreateInfo vertShaderStageInfo {};
@@ -549,7 +1265,7 @@ private:
         vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
         vertShaderStageInfo.module = vertShaderModule;
         vertShaderStageInfo.pName = "main";
-        vertShaderStageInfo.pSpecializationInfo = nullptr;  // used to optimize constant variables
+        vertShaderStageInfo.pSpecializationInfo = &objectSpecialization;  // where per object data is read from
 
         // fragment shader stage creation
         VkPipelineShaderStageCreateInfo fragShaderStageInfo {};
@@ -557,11 +1273,20 @@ private:
         fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
         fragShaderStageInfo.module = fragShaderModule;
         fragShaderStageInfo.pName = "main";
-        fragShaderStageInfo.pSpecializationInfo = nullptr;  // used to optimize constant variables
+        fragShaderStageInfo.pSpecializationInfo = fragSpecialization;  // used to optimize constant variables
 
-        VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
-
-        // fixed function pipeline setup - vertex input, no vertex data for now
+        // libraries only take the stages of their own parts
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+        if ( libraryParts == 0 || ( libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT ) )
+        {
+            shaderStages.push_back ( vertShaderStageInfo );
+        }
+        if ( libraryParts == 0 || ( libraryParts & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT ) )
+        {
+            shaderStages.push_back ( fragShaderStageInfo );
+        }
+
+        // fixed function pipeline setup - vertex input, no vertex data for now
         VkPipelineVertexInputStateCreateInfo vertexInputInfo {};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
         vertexInputInfo.vertexBindingDescriptionCount = 0;
@@ -572,30 +1297,17 @@ private:
         // fixed function pipeline setup - input assembly
         VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
         inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        inputAssembly.topology = pipelineState.topology_;
         inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-        // viewport
-        VkViewport viewport {};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = ( float ) swapChainExtent.width;
-        viewport.height = ( float ) swapChainExtent.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        // scizzor rectangle
-        VkRect2D scissor {};
-        scissor.offset = { 0,0 };
-        scissor.extent = swapChainExtent;
-
-        // combine viewport and scizzor rectangle into a viewport state
+        // viewport and scizzor rectangle are dynamic, only their count is part of the pipeline
+        // so the pipeline does not depend on the swap chain extent
         VkPipelineViewportStateCreateInfo viewportState {};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
+        viewportState.pViewports = nullptr;
         viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
+        viewportState.pScissors = nullptr;
 
         // rasterizer
         VkPipelineRasterizationStateCreateInfo rasterizer {};
@@ -604,8 +1316,8 @@ private:
         rasterizer.rasterizerDiscardEnable = VK_FALSE;
         rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
         rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-        rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+        rasterizer.cullMode = pipelineState.cull_mode_;      // ignored with extended dynamic state
+        rasterizer.frontFace = pipelineState.front_face_;
         rasterizer.depthBiasEnable = VK_FALSE;
         rasterizer.depthBiasConstantFactor = 0.0f;
         rasterizer.depthBiasClamp = 0.0f;
@@ -621,6 +1333,15 @@ private:
         multisampling.alphaToCoverageEnable = VK_FALSE;
         multisampling.alphaToOneEnable = VK_FALSE;
 
+        // depth testing, ignored while the render pass has no depth attachment
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = pipelineState.depth_test_;
+        depthStencil.depthWriteEnable = pipelineState.depth_write_;
+        depthStencil.depthCompareOp = pipelineState.depth_compare_;
+        depthStencil.depthBoundsTestEnable = VK_FALSE;
+        depthStencil.stencilTestEnable = VK_FALSE;
+
         // color blending
         VkPipelineColorBlendAttachmentState colorBlendAttachment {};
         colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
@@ -655,38 +1376,33 @@ private:
         colorBlending.blendConstants[ 2 ] = 0.0f;
         colorBlending.blendConstants[ 3 ] = 0.0f;
 
-        // setting dynamic states of the pipeline to modify it without recreating entire pipeline
-        VkDynamicState dynamicStates[] = {
-            VK_DYNAMIC_STATE_VIEWPORT,
-            VK_DYNAMIC_STATE_LINE_WIDTH
-        };
+        // setting dynamic states of the pipeline to modify it without recreating entire pipeline,
+        // values are recorded with JZvk::CmdSetDynamicState
+        std::vector<VkDynamicState> dynamicStates = JZvk::GetDynamicStates ( deviceCapabilities );
 
         VkPipelineDynamicStateCreateInfo dynamicState {};
         dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-        dynamicState.dynamicStateCount = 2;
-        dynamicState.pDynamicStates = dynamicStates;
-
-        // uniform variables in shaders, pipeline layout
-
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo {};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = nullptr;
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-
-        if ( vkCreatePipelineLayout ( device , &pipelineLayoutInfo , nullptr , &pipelineLayout ) != VK_SUCCESS )
-        {
-            throw std::runtime_error ( "failed to create pipeline layout!" );
-        }
+        dynamicState.dynamicStateCount = static_cast< uint32_t >( dynamicStates.size () );
+        dynamicState.pDynamicStates = dynamicStates.data ();
 
         // creating pipeline
         VkGraphicsPipelineCreateInfo pipelineInfo {};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 
+        // state outside the library parts being built is ignored
+        VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo {};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryInfo.flags = libraryParts;
+        if ( libraryParts != 0 )
+        {
+            pipelineInfo.pNext = &libraryInfo;
+            // kept so the background link can still optimize across the parts
+            pipelineInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+        }
+
         // shader stages
-        pipelineInfo.stageCount = 2;
-        pipelineInfo.pStages = shaderStages;
+        pipelineInfo.stageCount = static_cast< uint32_t >( shaderStages.size () );
+        pipelineInfo.pStages = shaderStages.data ();
 
         // fixed function
         pipelineInfo.pVertexInputState = &vertexInputInfo;
@@ -694,9 +1410,9 @@ private:
         pipelineInfo.pViewportState = &viewportState;
         pipelineInfo.pRasterizationState = &rasterizer;
         pipelineInfo.pMultisampleState = &multisampling;
-        pipelineInfo.pDepthStencilState = nullptr; // Optional
+        pipelineInfo.pDepthStencilState = &depthStencil;
         pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.pDynamicState = nullptr;
+        pipelineInfo.pDynamicState = &dynamicState;
 
         // pipeline layout
         pipelineInfo.layout = pipelineLayout;
@@ -709,14 +1425,13 @@ private:
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
         pipelineInfo.basePipelineIndex = -1;
 
-        if ( vkCreateGraphicsPipelines ( device , VK_NULL_HANDLE , 1 , &pipelineInfo , nullptr , &graphicsPipeline ) != VK_SUCCESS )
+        VkPipeline pipeline;
+        if ( vkCreateGraphicsPipelines ( device , cache , 1 , &pipelineInfo , nullptr , &pipeline ) != VK_SUCCESS )
         {
             throw std::runtime_error ( "failed to create graphics pipeline!" );
         }
 
-        // clean up local shader modules after compiling and linking
-        vkDestroyShaderModule ( device , fragShaderModule , nullptr );
-        vkDestroyShaderModule ( device , vertShaderModule , nullptr );
+        return pipeline;
     }
 
     void createImageViews ()
@@ -1016,57 +1731,843 @@ private:
     //    }
     //}
 
-    void mainLoop()
+    /*!
+        BENCHMARKS - START
+    */
+    void runBenchmark ( std::string const& name )
+    {
+        if ( name == "specialization" )
+        {
+            benchmarkSpecialization ();
+        }
+        else if ( name == "descriptors" )
+        {
+            benchmarkDescriptors ();
+        }
+        else if ( name == "pushdescriptors" )
+        {
+            benchmarkPushDescriptors ();
+        }
+        else if ( name == "shadermodules" )
+        {
+            benchmarkShaderModules ();
+        }
+        else if ( name == "dispatch" )
+        {
+            benchmarkDispatch ();
+        }
+        else if ( name == "log" )
+        {
+            benchmarkLog ();
+        }
+        else if ( name == "frames" )
+        {
+            benchmarkFrames ();
+        }
+        else
+        {
+            throw std::runtime_error ( "unknown benchmark: " + name );
+        }
+
+        vkDeviceWaitIdle ( device );
+    }
+
+    // swapchain image held for a whole benchmark run, with its own command buffer
+    struct BenchmarkTarget
+    {
+        VkFence fence;
+        VkCommandPool commandPool;
+        VkCommandBuffer commandBuffer;
+        uint32_t imageIndex;
+    };
+
+    BenchmarkTarget beginBenchmarkTarget ()
+    {
+        BenchmarkTarget target {};
+
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if ( vkCreateFence ( device , &fenceInfo , nullptr , &target.fence ) != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to create benchmark fence!" );
+        }
+
+        // hold one swapchain image for the whole run, it is presented at the end
+        if ( headless )
+        {
+            target.imageIndex = 0;
+        }
+        else
+        {
+            JZvk::Dispatch ().AcquireNextImageKHR ( device , swapChain , UINT64_MAX , VK_NULL_HANDLE , target.fence , &target.imageIndex );
+            JZvk::Dispatch ().WaitForFences ( device , 1 , &target.fence , VK_TRUE , UINT64_MAX );
+            JZvk::Dispatch ().ResetFences ( device , 1 , &target.fence );
+        }
+
+        // own pool, reset wholesale after every frame
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = deviceContext.queue_family_indices_.graphics_family_.value ();
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        if ( vkCreateCommandPool ( device , &poolInfo , nullptr , &target.commandPool ) != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to create benchmark command pool!" );
+        }
+
+        VkCommandBufferAllocateInfo allocInfo {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = target.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if ( vkAllocateCommandBuffers ( device , &allocInfo , &target.commandBuffer ) != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to allocate benchmark command buffer!" );
+        }
+
+        return target;
+    }
+
+    // begins the command buffer and render pass, and binds pipeline and frame wide state
+    void beginBenchmarkPass ( BenchmarkTarget const& target , VkPipeline pipeline , JZvk::PermutationKey flags )
+    {
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        JZvk::Dispatch ().BeginCommandBuffer ( target.commandBuffer , &beginInfo );
+
+        VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+        VkRenderPassBeginInfo renderPassInfo {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = swapChainFramebuffers[ target.imageIndex ];
+        renderPassInfo.renderArea.offset = { 0,0 };
+        renderPassInfo.renderArea.extent = swapChainExtent;
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearColor;
+
+        JZvk::Dispatch ().CmdBeginRenderPass ( target.commandBuffer , &renderPassInfo , VK_SUBPASS_CONTENTS_INLINE );
+        JZvk::Dispatch ().CmdBindPipeline ( target.commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline );
+        JZvk::CmdSetDynamicState ( target.commandBuffer , pipelineState );
+        if ( bindlessTable.Enabled () )
+        {
+            bindlessTable.Bind ( target.commandBuffer , pipelineLayout , BINDLESS_SET );
+        }
+        MaterialConstants material { flags , JZvk::BindlessTable::INVALID_INDEX , materialTintIndex };
+        JZvk::Dispatch ().CmdPushConstants ( target.commandBuffer , pipelineLayout , VK_SHADER_STAGE_FRAGMENT_BIT , 0 , sizeof ( material ) , &material );
+
+        // every draw of a benchmark reuses one object, submitBenchmarkPass waits so frame 0 is free
+        ObjectUniforms object;
+        objectUniforms.BeginFrame ( 0 );
+        objectUniforms.Bind ( target.commandBuffer , pipelineLayout , OBJECT_SET , &object );
+    }
+
+    // ends the render pass, submits and waits, then recycles the command buffer
+    void submitBenchmarkPass ( BenchmarkTarget const& target )
+    {
+        JZvk::Dispatch ().CmdEndRenderPass ( target.commandBuffer );
+        JZvk::Dispatch ().EndCommandBuffer ( target.commandBuffer );
+
+        VkSubmitInfo submitInfo {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &target.commandBuffer;
+        JZvk::Dispatch ().QueueSubmit ( graphicsQueue , 1 , &submitInfo , target.fence );
+        JZvk::Dispatch ().WaitForFences ( device , 1 , &target.fence , VK_TRUE , UINT64_MAX );
+        JZvk::Dispatch ().ResetFences ( device , 1 , &target.fence );
+        JZvk::Dispatch ().ResetCommandPool ( device , target.commandPool , 0 );
+    }
+
+    void endBenchmarkTarget ( BenchmarkTarget& target )
+    {
+        // give the held image back to the presentation engine
+        if ( !headless )
+        {
+            VkPresentInfoKHR presentInfo {};
+            presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+            presentInfo.swapchainCount = 1;
+            presentInfo.pSwapchains = &swapChain;
+            presentInfo.pImageIndices = &target.imageIndex;
+            JZvk::Dispatch ().QueuePresentKHR ( presentQueue , &presentInfo );
+        }
+
+        vkDestroyCommandPool ( device , target.commandPool , nullptr );
+        vkDestroyFence ( device , target.fence , nullptr );
+    }
+
+    // fragment cost of runtime feature branches against specialized permutations,
+    // each frame draws many overlapping triangles so fragment shading dominates
+    void benchmarkSpecialization ()
+    {
+        const uint32_t overdraw = 256;
+        const int warmupFrames = 10;
+        const int measuredFrames = 100;
+
+        BenchmarkTarget target = beginBenchmarkTarget ();
+
+        auto renderFrame = [ & ] ( VkPipeline pipeline , JZvk::PermutationKey flags )
+        {
+            beginBenchmarkPass ( target , pipeline , flags );
+            for ( uint32_t i = 0; i < overdraw; ++i )
+            {
+                JZvk::Dispatch ().CmdDraw ( target.commandBuffer , 3 , 1 , 0 , 0 );
+            }
+            submitBenchmarkPass ( target );
+        };
+
+        JZvk::PermutationKey const allFeatures = fragPermutations.FeatureBit ( "FEATURE_PATTERN" ) | fragPermutations.FeatureBit ( "FEATURE_GRADING" );
+
+        // pipelines are built before timing starts
+        struct Case { std::string name; VkPipeline pipeline; JZvk::PermutationKey flags; };
+        std::vector<Case> cases = {
+            { "runtime branches, all features" , pipelinePermutations.Get ( allFeatures , false ) , allFeatures },
+            { "specialized, all features" , pipelinePermutations.Get ( allFeatures ) , allFeatures },
+            { "runtime branches, no features" , pipelinePermutations.Get ( 0 , false ) , 0 },
+            { "specialized, no features" , pipelinePermutations.Get ( 0 ) , 0 }
+        };
+
+        std::vector<JZvk::Bench::Result> results;
+        for ( auto const& benchCase : cases )
+        {
+            // the permutation failed to build and was logged
+            if ( benchCase.pipeline == VK_NULL_HANDLE )
+            {
+                continue;
+            }
+            results.push_back ( JZvk::Bench::Measure ( benchCase.name , warmupFrames , measuredFrames ,
+                                                       [ & ] () { renderFrame ( benchCase.pipeline , benchCase.flags ); } ) );
+        }
+
+        JZvk::Bench::Report ( "fragment cost per frame, " + std::to_string ( overdraw ) + " overlapping triangles at "
+                              + std::to_string ( swapChainExtent.width ) + "x" + std::to_string ( swapChainExtent.height ) , results );
+
+        endBenchmarkTarget ( target );
+    }
+
+    // cpu cost of recording per draw bindings, push descriptors against sets taken
+    // from a per frame allocator, each with and without an update template
+    void benchmarkPushDescriptors ()
+    {
+        const uint32_t drawsPerFrame = 4096;
+        const VkDeviceSize sliceSize = 256;     // largest minUniformBufferOffsetAlignment allowed
+        const int warmupFrames = 10;
+        const int measuredFrames = 100;
+
+        BenchmarkTarget target = beginBenchmarkTarget ();
+
+        JZvk::Buffer uniforms = JZvk::Create::VKBuffer ( device , physicalDevice , sliceSize * drawsPerFrame , VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT ,
+                                                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+
+        // same bindings forced onto descriptor sets, with its own pipeline layout for set DRAW_SET
+        JZvk::TransientBindings fallbackBindings;
+        fallbackBindings.Initialize ( device , deviceCapabilities , descriptorLayouts , drawBindingLayout () , false );
+        VkPipelineLayout fallbackLayout = createPipelineLayout ( fallbackBindings.Layout () );
+        if ( !fallbackBindings.Finalize ( fallbackLayout , DRAW_SET , drawBindingEntries () ) )
+        {
+            throw std::runtime_error ( "failed to create fallback draw binding update template!" );
+        }
+
+        JZvk::DescriptorAllocator benchAllocator;
+        benchAllocator.Initialize ( device );
+
+        // only recording is timed, submission is the same for every case
+        auto measure = [ & ] ( std::string const& name , auto&& bindDraw )
+        {
+            JZvk::Bench::Result result { name , {} };
+            for ( int frame = 0; frame < warmupFrames + measuredFrames; ++frame )
+            {
+                auto const start = std::chrono::steady_clock::now ();
+                beginBenchmarkPass ( target , graphicsPipeline , materialFeatures );
+                for ( uint32_t i = 0; i < drawsPerFrame; ++i )
+                {
+                    // nothing bound, the allocator is out of sets
+                    if ( bindDraw ( i ) )
+                    {
+                        JZvk::Dispatch ().CmdDraw ( target.commandBuffer , 3 , 1 , 0 , 0 );
+                    }
+                }
+                double const ms = std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count ();
+
+                submitBenchmarkPass ( target );
+                benchAllocator.Reset ();
+                if ( frame >= warmupFrames )
+                {
+                    result.samples_ms_.push_back ( ms );
+                }
+            }
+            return result;
+        };
+
+        auto viaTemplate = [ & ] ( JZvk::TransientBindings const& bindings )
+        {
+            return [ &bindings , &uniforms , &target , &benchAllocator , sliceSize ] ( uint32_t draw )
+            {
+                VkDescriptorBufferInfo data { uniforms.buffer_ , draw * sliceSize , sliceSize };
+                return bindings.Bind ( target.commandBuffer , benchAllocator , &data );
+            };
+        };
+        auto viaWrites = [ & ] ( JZvk::TransientBindings const& bindings )
+        {
+            return [ &bindings , &uniforms , &target , &benchAllocator , sliceSize ] ( uint32_t draw )
+            {
+                VkDescriptorBufferInfo data { uniforms.buffer_ , draw * sliceSize , sliceSize };
+                std::vector<VkWriteDescriptorSet> writes ( 1 );
+                writes[ 0 ].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[ 0 ].dstBinding = 0;
+                writes[ 0 ].descriptorCount = 1;
+                writes[ 0 ].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                writes[ 0 ].pBufferInfo = &data;
+                return bindings.BindWrites ( target.commandBuffer , benchAllocator , writes );
+            };
+        };
+
+        std::vector<JZvk::Bench::Result> results;
+        if ( drawBindings.Pushed () )
+        {
+            results.push_back ( measure ( "push descriptors, template" , viaTemplate ( drawBindings ) ) );
+            results.push_back ( measure ( "push descriptors, writes" , viaWrites ( drawBindings ) ) );
+        }
+        else
+        {
+            std::cout << "VK_KHR_push_descriptor not supported, measuring the fallback only" << std::endl;
+        }
+        results.push_back ( measure ( "frame allocator, template" , viaTemplate ( fallbackBindings ) ) );
+        results.push_back ( measure ( "frame allocator, writes" , viaWrites ( fallbackBindings ) ) );
+
+        JZvk::Bench::Report ( "cpu recording time per frame of " + std::to_string ( drawsPerFrame ) + " draws with per draw bindings" , results );
+
+        endBenchmarkTarget ( target );
+
+        benchAllocator.Destroy ();
+        fallbackBindings.Destroy ();
+        vkDestroyPipelineLayout ( device , fallbackLayout , nullptr );
+        JZvk::DestroyBuffer ( device , uniforms );
+    }
+
+    // cpu cost per draw of calling through the loader's exported trampolines against
+    // pointers loaded with vkGetDeviceProcAddr, only the draw loop is timed
+    void benchmarkDispatch ()
+    {
+        const uint32_t drawsPerFrame = 16384;
+        const int warmupFrames = 10;
+        const int measuredFrames = 100;
+
+        BenchmarkTarget target = beginBenchmarkTarget ();
+
+        // push constants and a draw, the two calls every object of recordCommandBuffer makes
+        auto measure = [ & ] ( std::string const& name , JZvk::DeviceDispatch const& dispatch )
+        {
+            JZvk::Bench::Result result { name , {} };
+            for ( int frame = 0; frame < warmupFrames + measuredFrames; ++frame )
+            {
+                beginBenchmarkPass ( target , graphicsPipeline , materialFeatures );
+
+                auto const start = std::chrono::steady_clock::now ();
+                for ( uint32_t i = 0; i < drawsPerFrame; ++i )
+                {
+                    MaterialConstants material { materialFeatures , JZvk::BindlessTable::INVALID_INDEX , materialTintIndex };
+                    dispatch.CmdPushConstants ( target.commandBuffer , pipelineLayout , VK_SHADER_STAGE_FRAGMENT_BIT , 0 , sizeof ( material ) , &material );
+                    dispatch.CmdDraw ( target.commandBuffer , 3 , 1 , 0 , 0 );
+                }
+                double const ms = std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count ();
+
+                submitBenchmarkPass ( target );
+                if ( frame >= warmupFrames )
+                {
+                    result.samples_ms_.push_back ( ms );
+                }
+            }
+            return result;
+        };
+
+        std::vector<JZvk::Bench::Result> results;
+        results.push_back ( measure ( "loader trampolines" , JZvk::DeviceDispatch {} ) );
+        results.push_back ( measure ( "vkGetDeviceProcAddr" , JZvk::GetDeviceDispatch ( device ) ) );
+
+        JZvk::Bench::Report ( "cpu recording time per frame of " + std::to_string ( drawsPerFrame ) + " draws" , results );
+        for ( auto const& result : results )
+        {
+            std::cout << result.name_ << ": " << result.Percentile ( 0.5 ) * 1.0e6 / drawsPerFrame << " ns per draw (p50)" << std::endl;
+        }
+
+        endBenchmarkTarget ( target );
+    }
+
+    // producer side cost of a JZvk::Log call, from one thread and from several at once.
+    // batches stay below the ring's capacity and the ring is drained between them, untimed
+    void benchmarkLog ()
+    {
+        const int callsPerBatch = 1024;
+        const int warmupBatches = 10;
+        const int measuredBatches = 200;
+        const int producers = 4;
+
+        std::string const name = "swapchain";
+
+        auto timed = [] ( auto&& function )
+        {
+            auto const start = std::chrono::steady_clock::now ();
+            function ();
+            return std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count ();
+        };
+
+        auto logBatch = [ & ] ( int calls )
+        {
+            for ( int i = 0; i < calls; ++i )
+            {
+                JZvk::Log ( JZvk::LOG::INFO , "\t" , name , " image " , i , " of " , callsPerBatch , ", " , 0.5 * i , " ms" );
+            }
+        };
+
+        // same line through a stream, what every call cost before the writer thread, less the write itself
+        auto streamBatch = [ & ] ()
+        {
+            for ( int i = 0; i < callsPerBatch; ++i )
+            {
+                std::ostringstream stream;
+                stream << "\t" << name << " image " << i << " of " << callsPerBatch << ", " << 0.5 * i << " ms" << std::endl;
+            }
+        };
+
+        // batch returns its own time, so the threaded case can leave thread start up out of it
+        auto measure = [ & ] ( std::string const& caseName , auto&& batch )
+        {
+            JZvk::Bench::Result result { caseName , {} };
+            for ( int i = 0; i < warmupBatches + measuredBatches; ++i )
+            {
+                double const ms = batch ();
+                JZvk::FlushLog ();
+                if ( i >= warmupBatches )
+                {
+                    result.samples_ms_.push_back ( ms );
+                }
+            }
+            return result;
+        };
+
+        // records are still formatted and queued, only the writes are skipped
+        JZvk::SetLogMuted ( true );
+
+        std::vector<JZvk::Bench::Result> results;
+        results.push_back ( measure ( "Log, 1 producer" , [ & ] () { return timed ( [ & ] () { logBatch ( callsPerBatch ); } ); } ) );
+        results.push_back ( measure ( "Log, " + std::to_string ( producers ) + " producers" , [ & ] ()
+        {
+            // threads start together and the slowest one is the batch time
+            std::atomic<bool> go { false };
+            std::vector<double> ms ( producers );
+            std::vector<std::thread> threads;
+            for ( int p = 0; p < producers; ++p )
+            {
+                threads.emplace_back ( [ & , p ] ()
+                {
+                    while ( !go.load () )
+                    {
+                        std::this_thread::yield ();
+                    }
+                    ms[ p ] = timed ( [ & ] () { logBatch ( callsPerBatch / producers ); } );
+                } );
+            }
+            go.store ( true );
+            for ( auto& thread : threads )
+            {
+                thread.join ();
+            }
+            return *std::max_element ( ms.begin () , ms.end () );
+        } ) );
+        results.push_back ( measure ( "std::ostringstream" , [ & ] () { return timed ( streamBatch ); } ) );
+
+        JZvk::FlushLog ();
+        JZvk::SetLogMuted ( false );
+
+        JZvk::Bench::Report ( "cpu time per batch of " + std::to_string ( callsPerBatch ) + " log calls" , results );
+        for ( auto const& result : results )
+        {
+            std::cout << result.name_ << ": " << result.Percentile ( 0.5 ) * 1.0e6 / callsPerBatch << " ns per call (p50)" << std::endl;
+        }
+    }
+
+    // module size and vkCreateShaderModule cost of the modules as compiled, neither optimized nor stripped,
+    // against the optimized and stripped ones the renderer loads
+    void benchmarkShaderModules ()
+    {
+        const int warmupIterations = 10;
+        const int measuredIterations = 200;
+
+        JZvk::ShaderArchive baselineArchive;
+        if ( !baselineArchive.Open ( JZvk::Shader::BASELINE_ARCHIVE_PATH ) )
+        {
+            throw std::runtime_error ( "failed to open baseline shader archive, run shaders/compile first!" );
+        }
+
+        std::vector<JZvk::Bench::Result> results;
+        for ( std::string const name : { "shader.vert" , "shader.frag" } )
+        {
+            JZvk::SPIRVView baselineCode = baselineArchive.Find ( name );
+            JZvk::SPIRVView releaseCode = JZvk::Shader::Find ( name );
+            if ( baselineCode.Empty () || releaseCode.Empty () )
+            {
+                throw std::runtime_error ( "shader missing from archive: " + name );
+            }
+            std::cout << name << ": " << baselineCode.size_ << " bytes as compiled, " << releaseCode.size_ << " bytes optimized and stripped" << std::endl;
+
+            auto createModule = [ this ] ( JZvk::SPIRVView code )
+            {
+                return [ this , code ] ()
+                {
+                    vkDestroyShaderModule ( device , createShaderModule ( code ) , nullptr );
+                };
+            };
+            results.push_back ( JZvk::Bench::Measure ( name + ", as compiled" , warmupIterations , measuredIterations , createModule ( baselineCode ) ) );
+            results.push_back ( JZvk::Bench::Measure ( name + ", optimized and stripped" , warmupIterations , measuredIterations , createModule ( releaseCode ) ) );
+        }
+
+        JZvk::Bench::Report ( "vkCreateShaderModule and vkDestroyShaderModule per module" , results );
+    }
+
+    // cpu cost of allocating a frame worth of transient descriptor sets,
+    // growable chained pools against a pool per frame and freeing sets one by one
+    void benchmarkDescriptors ()
+    {
+        const uint32_t setsPerFrame = 4096;
+        const int warmupFrames = 10;
+        const int measuredFrames = 100;
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings = {
+            { 0 , VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER , 1 , VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT , nullptr },
+            { 1 , VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , 1 , VK_SHADER_STAGE_FRAGMENT_BIT , nullptr }
+        };
+        VkDescriptorSetLayout layout = descriptorLayouts.Get ( bindings );
+
+        std::vector<VkDescriptorPoolSize> frameSizes = {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER , setsPerFrame },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , setsPerFrame }
+        };
+        auto createFramePool = [ & ] ( VkDescriptorPoolCreateFlags flags )
+        {
+            VkDescriptorPoolCreateInfo poolInfo {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.flags = flags;
+            poolInfo.maxSets = setsPerFrame;
+            poolInfo.poolSizeCount = static_cast< uint32_t >( frameSizes.size () );
+            poolInfo.pPoolSizes = frameSizes.data ();
+
+            VkDescriptorPool pool;
+            if ( vkCreateDescriptorPool ( device , &poolInfo , nullptr , &pool ) != VK_SUCCESS )
+            {
+                throw std::runtime_error ( "failed to create benchmark descriptor pool!" );
+            }
+            return pool;
+        };
+
+        VkDescriptorSetAllocateInfo allocInfo {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        std::vector<VkDescriptorSet> sets ( setsPerFrame );
+        std::vector<JZvk::Bench::Result> results;
+
+        // starts at 64 sets per pool and chains, pools are kept across resets
+        JZvk::DescriptorAllocator growable;
+        growable.Initialize ( device , 64 );
+        results.push_back ( JZvk::Bench::Measure ( "growable allocator, reset per frame" , warmupFrames , measuredFrames , [ & ] ()
+            {
+                for ( uint32_t i = 0; i < setsPerFrame; ++i )
+                {
+                    sets[ i ] = growable.Allocate ( layout );
+                }
+                growable.Reset ();
+            } ) );
+        size_t const growablePools = growable.PoolCount ();
+        growable.Destroy ();
+
+        results.push_back ( JZvk::Bench::Measure ( "pool created and destroyed per frame" , warmupFrames , measuredFrames , [ & ] ()
+            {
+                allocInfo.descriptorPool = createFramePool ( 0 );
+                for ( uint32_t i = 0; i < setsPerFrame; ++i )
+                {
+                    JZvk::Dispatch ().AllocateDescriptorSets ( device , &allocInfo , &sets[ i ] );
+                }
+                vkDestroyDescriptorPool ( device , allocInfo.descriptorPool , nullptr );
+            } ) );
+
+        VkDescriptorPool freeingPool = createFramePool ( VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT );
+        allocInfo.descriptorPool = freeingPool;
+        results.push_back ( JZvk::Bench::Measure ( "one pool, sets freed individually" , warmupFrames , measuredFrames , [ & ] ()
+            {
+                for ( uint32_t i = 0; i < setsPerFrame; ++i )
+                {
+                    JZvk::Dispatch ().AllocateDescriptorSets ( device , &allocInfo , &sets[ i ] );
+                }
+                for ( uint32_t i = 0; i < setsPerFrame; ++i )
+                {
+                    vkFreeDescriptorSets ( device , freeingPool , 1 , &sets[ i ] );
+                }
+            } ) );
+        vkDestroyDescriptorPool ( device , freeingPool , nullptr );
+
+        // layout lookups, as done when building pipeline layouts per material
+        results.push_back ( JZvk::Bench::Measure ( "layout cache lookup" , warmupFrames , measuredFrames , [ & ] ()
+            {
+                for ( uint32_t i = 0; i < setsPerFrame; ++i )
+                {
+                    descriptorLayouts.Get ( bindings );
+                }
+            } ) );
+
+        JZvk::Bench::Report ( "cpu time per frame of " + std::to_string ( setsPerFrame ) + " descriptor sets" , results );
+        for ( auto const& result : results )
+        {
+            std::cout << "  " << result.name_ << ": " << static_cast< uint64_t >( setsPerFrame / result.Mean () * 1000.0 ) << " per second" << std::endl;
+        }
+        std::cout << "  growable allocator settled on " << growablePools << " pools" << std::endl;
+    }
+
+    // renders warmupFrames, then measures headlessFrames frames of the scene: the cpu time of each drawFrame
+    // and the gpu time of its "frame" zone. written as JSON to reportPath, or stdout
+    void benchmarkFrames ()
     {
-        // glfw window loop
-        while (!glfwWindowShouldClose(window))
+        JZvk::Bench::Result cpuFrame { "cpu frame" , {} };
+        JZvk::Bench::Result gpuFrame { "gpu frame" , {} };
+        cpuFrame.samples_ms_.reserve ( headlessFrames );
+        gpuFrame.samples_ms_.reserve ( headlessFrames );
+
+        // gpu time of the frame the last Retire read back, recorded framesInFlight frames earlier
+        auto const recordGpuFrame = [ this , &gpuFrame ] ()
+        {
+            for ( auto const& zone : gpuProfiler.LastFrame () )
+            {
+                if ( zone.depth_ == 0 && std::strcmp ( zone.name_ , "frame" ) == 0 )
+                {
+                    gpuFrame.samples_ms_.push_back ( static_cast< double >( zone.end_ns_ - zone.begin_ns_ ) * 1e-6 );
+                }
+            }
+        };
+
+        for ( uint32_t i = 0; i < warmupFrames; ++i )
         {
-            // process glfw events
-            glfwPollEvents();
             drawFrame ();
         }
 
+        auto const start = std::chrono::steady_clock::now ();
+        for ( uint32_t i = 0; i < headlessFrames; ++i )
+        {
+            auto const frameStart = std::chrono::steady_clock::now ();
+            drawFrame ();
+            cpuFrame.samples_ms_.push_back ( std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - frameStart ).count () );
+
+            // the first framesInFlight draws retire warm up frames
+            if ( i >= framesInFlight )
+            {
+                recordGpuFrame ();
+            }
+        }
+        vkDeviceWaitIdle ( device );
+        double const elapsedMs = std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count ();
+
+        // the measured frames still in flight, oldest first. currentFrame is the slot the next frame would use
+        for ( uint32_t i = framesInFlight - std::min ( framesInFlight , headlessFrames ); i < framesInFlight; ++i )
+        {
+            gpuProfiler.Retire ( static_cast< uint32_t >( ( currentFrame + i ) % framesInFlight ) );
+            recordGpuFrame ();
+        }
+
+        // log lines written so far come first when both go to stdout
+        JZvk::FlushLog ();
+
+        std::ofstream file;
+        if ( !reportPath.empty () )
+        {
+            file.open ( reportPath );
+            if ( !file )
+            {
+                throw std::runtime_error ( "failed to open benchmark report " + reportPath + "!" );
+            }
+        }
+        std::ostream& out = reportPath.empty () ? std::cout : file;
+
+        out << "{\n";
+        out << "  \"device\": ";
+        JZvk::Bench::WriteJsonString ( out , deviceContext.properties_.deviceName );
+        out << ",\n";
+        out << "  \"scene\": \"" << JZvk::Bench::SceneKindName ( sceneKind ) << "\",\n";
+        out << "  \"objects\": " << sceneObjects.size () << ",\n";
+        out << "  \"resolution\": [ " << swapChainExtent.width << ", " << swapChainExtent.height << " ],\n";
+        out << "  \"frames_in_flight\": " << framesInFlight << ",\n";
+        out << "  \"present\": \"" << ( headless ? "headless" : JZvk::PresentModeName ( presentMode ) ) << "\",\n";
+        out << "  \"object_uniforms\": \"" << ( objectUniforms.PushesConstants () ? "push constants" : "dynamic offsets" ) << "\",\n";
+        out << "  \"warmup_frames\": " << warmupFrames << ",\n";
+        out << "  \"measured_frames\": " << headlessFrames << ",\n";
+        out << "  \"frames_per_second\": " << ( elapsedMs > 0.0 ? headlessFrames * 1000.0 / elapsedMs : 0.0 ) << ",\n";
+        out << "  \"cpu_frame\": ";
+        JZvk::Bench::WriteJson ( out , cpuFrame );
+        out << ",\n";
+        // null without timestamp support
+        out << "  \"gpu_frame\": ";
+        if ( gpuProfiler.Enabled () && !gpuFrame.samples_ms_.empty () )
+        {
+            JZvk::Bench::WriteJson ( out , gpuFrame );
+        }
+        else
+        {
+            out << "null";
+        }
+        out << "\n}" << std::endl;
+
+        if ( !reportPath.empty () )
+        {
+            std::cout << "frame benchmark written to " << reportPath << std::endl;
+        }
+    }
+    /*!
+        BENCHMARKS - END
+    */
+
+    void mainLoop()
+    {
+        if ( headless )
+        {
+            // no window to close, a fixed number of frames instead
+            for ( uint32_t i = 0; i < headlessFrames; ++i )
+            {
+                drawFrame ();
+            }
+        }
+        else
+        {
+            // glfw window loop
+            while (!glfwWindowShouldClose(window))
+            {
+                // process glfw events
+                glfwPollEvents();
+                drawFrame ();
+            }
+        }
+
         vkDeviceWaitIdle ( device );
+        reportPresentStats ();
     }
 
     void drawFrame ()
     {
+        JZVK_PROFILE_FUNCTION ();
+
+        auto const frameStart = std::chrono::steady_clock::now ();
+
         // wait for frame to be finished before drawing next frame
-        vkWaitForFences ( device , 1 , &inFlightFences[ currentFrame ] , VK_TRUE , UINT64_MAX );
+        {
+            JZVK_PROFILE_ZONE ( "wait for frame fence" );
+            JZvk::Dispatch ().WaitForFences ( device , 1 , &inFlightFences[ currentFrame ] , VK_TRUE , UINT64_MAX );
+        }
+
+        destroyRetiredSwapchains ( false );
+
+        if ( requestedPresentPolicy != presentPolicy )
+        {
+            switchPresentPolicy ();
+        }
 
         uint32_t imageIndex;
-        vkAcquireNextImageKHR ( device , swapChain , UINT64_MAX , imageAvailableSemaphores[currentFrame] , VK_NULL_HANDLE , &imageIndex );
+        if ( headless )
+        {
+            // one offscreen target per frame in flight, freed by the fence wait above
+            imageIndex = static_cast< uint32_t >( currentFrame );
+        }
+        else
+        {
+            JZVK_PROFILE_ZONE ( "acquire" );
+            VkResult acquireResult = JZvk::Dispatch ().AcquireNextImageKHR ( device , swapChain , UINT64_MAX , imageAvailableSemaphores[currentFrame] , VK_NULL_HANDLE , &imageIndex );
+
+            // nothing was submitted and the fence is still signaled, so the frame can simply start over
+            if ( acquireResult == VK_ERROR_OUT_OF_DATE_KHR )
+            {
+                recreateSwapChain ();
+                return;
+            }
+            // suboptimal images can still be presented, the swap chain is recreated after the present
+            if ( acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR )
+            {
+                throw std::runtime_error ( "failed to acquire swap chain image!" );
+            }
+        }
+
+        // only once an image was acquired, a frame started over after an out of date acquire
+        // would otherwise retire its slot and record its frame time twice
+        if ( lastFrameStart )
+        {
+            presentStats[ presentMode ].frameTime.Record ( std::chrono::duration<double , std::milli> ( frameStart - *lastFrameStart ).count () );
+        }
+        lastFrameStart = frameStart;
+
+        // the gpu is done with this frame's transient descriptor sets and uniform slices
+        frameDescriptors[ currentFrame ].Reset ();
+        objectUniforms.BeginFrame ( static_cast< uint32_t >( currentFrame ) );
+        if ( frameReadback.Enabled () )
+        {
+            frameReadback.Retire ( static_cast< uint32_t >( currentFrame ) );
+        }
+        gpuProfiler.Retire ( static_cast< uint32_t >( currentFrame ) );
+        // the frame's gpu time is read back now, the next frames are rendered at the updated scale
+        if ( dynamicResolution.Enabled () )
+        {
+            dynamicResolution.Retire ( gpuProfiler , "frame" );
+        }
+        pipelineStatistics.Retire ( static_cast< uint32_t >( currentFrame ) );
+#ifdef JZVK_PROFILING
+        JZvk::Profiler::RecordGpuFrame ( gpuProfiler.LastFrame () , gpuSubmitTicks[ currentFrame ] );
+#endif
 
         // check if the previous frame is using this image
         if ( imagesInFlight[ imageIndex ] != VK_NULL_HANDLE )
         {
-            vkWaitForFences ( device , 1 , &imagesInFlight[ imageIndex ] , VK_TRUE , UINT64_MAX );
+            JZvk::Dispatch ().WaitForFences ( device , 1 , &imagesInFlight[ imageIndex ] , VK_TRUE , UINT64_MAX );
         }
 
         // mark image as now being used by this frame
         imagesInFlight[ imageIndex ] = inFlightFences[ currentFrame ];
 
+        // the fence wait above retired this frame's command buffer
+        JZvk::Dispatch ().ResetCommandBuffer ( commandBuffers[ currentFrame ] , 0 );
+        recordCommandBuffer ( commandBuffers[ currentFrame ] , imageIndex );
+
         // queue submission and synchronization
         VkSubmitInfo submitInfo {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         
         VkSemaphore waitSemaphore[] = { imageAvailableSemaphores[currentFrame] };
         VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-        submitInfo.waitSemaphoreCount = 1;
+        // headless frames neither wait for an acquire nor signal a present
+        submitInfo.waitSemaphoreCount = headless ? 0 : 1;
         submitInfo.pWaitSemaphores = waitSemaphore;
         submitInfo.pWaitDstStageMask = waitStages;
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffers[ imageIndex ];
+        submitInfo.pCommandBuffers = &commandBuffers[ currentFrame ];
 
         VkSemaphore signalSemaphores[] = { renderFinishedSemaphores[currentFrame] };
-        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.signalSemaphoreCount = headless ? 0 : 1;
         submitInfo.pSignalSemaphores = signalSemaphores;
 
-        vkResetFences ( device , 1 , &inFlightFences[ currentFrame ] );
+        JZvk::Dispatch ().ResetFences ( device , 1 , &inFlightFences[ currentFrame ] );
 
-        if ( vkQueueSubmit ( graphicsQueue , 1 , &submitInfo , inFlightFences[currentFrame] ) != VK_SUCCESS )
+#ifdef JZVK_PROFILING
+        gpuSubmitTicks[ currentFrame ] = JZvk::Profiler::Ticks ();
+#endif
         {
-            throw std::runtime_error ( "failed to submit draw command buffer!" );
+            JZVK_PROFILE_ZONE ( "submit" );
+            if ( JZvk::Dispatch ().QueueSubmit ( graphicsQueue , 1 , &submitInfo , inFlightFences[currentFrame] ) != VK_SUCCESS )
+            {
+                throw std::runtime_error ( "failed to submit draw command buffer!" );
+            }
+        }
+        ++frameNumber;
+        if ( enableValidationLayers )
+        {
+            JZvk::GetValidationSink ().EndFrame ( frameNumber );
+        }
+
+        if ( headless )
+        {
+            currentFrame = ( currentFrame + 1 ) % framesInFlight;
+            return;
         }
 
         VkPresentInfoKHR presentInfo {};
@@ -1081,15 +2582,35 @@ private:
 
         presentInfo.pResults = nullptr;
 
-        vkQueuePresentKHR ( presentQueue , &presentInfo );
+        VkResult presentResult;
+        {
+            JZVK_PROFILE_ZONE ( "present" );
+            presentResult = JZvk::Dispatch ().QueuePresentKHR ( presentQueue , &presentInfo );
+        }
 
-        currentFrame = ( currentFrame + 1 ) % MAX_FRAMES_IN_FLIGHT;
+        auto const presentEnd = std::chrono::steady_clock::now ();
+        if ( lastPresent )
+        {
+            presentStats[ presentMode ].presentInterval.Record ( std::chrono::duration<double , std::milli> ( presentEnd - *lastPresent ).count () );
+        }
+        lastPresent = presentEnd;
+
+        currentFrame = ( currentFrame + 1 ) % framesInFlight;
+
+        if ( presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR || framebufferResized )
+        {
+            recreateSwapChain ();
+        }
+        else if ( presentResult != VK_SUCCESS )
+        {
+            throw std::runtime_error ( "failed to present swap chain image!" );
+        }
     }
 
     void cleanup()
     {
         // clean up semaphores
-        for ( size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i )
+        for ( size_t i = 0; i < framesInFlight; ++i )
         {
             vkDestroySemaphore ( device , renderFinishedSemaphores[i] , nullptr );
             vkDestroySemaphore ( device , imageAvailableSemaphores[i] , nullptr );
@@ -1099,17 +2620,45 @@ private:
         // clean up command pool
         vkDestroyCommandPool ( device , commandPool , nullptr );
 
+        // swap chains replaced by a recreate, the device is idle by now
+        destroyRetiredSwapchains ( true );
+
         // clean up framebuffers
         for ( auto framebuffer : swapChainFramebuffers )
         {
             vkDestroyFramebuffer ( device , framebuffer , nullptr );
         }
 
-        // clean up pipeline layout
-        vkDestroyPipeline ( device , graphicsPipeline , nullptr );
+        if ( dynamicResolution.Enabled () )
+        {
+            dynamicResolution.Destroy ();
+        }
+        gpuProfiler.Destroy ();
+        pipelineStatistics.Destroy ();
+
+        // clean up pipelines, keeping what the driver compiled for the next run
+        pipelineLibrary.Destroy ();
+        pipelinePermutations.Destroy ();
+        JZvk::SavePipelineCache ( device , pipelineCache , PIPELINE_CACHE_FILE );
+        vkDestroyPipelineCache ( device , pipelineCache , nullptr );
+        vkDestroyShaderModule ( device , fragShaderModule , nullptr );
+        vkDestroyShaderModule ( device , vertShaderModule , nullptr );
         vkDestroyPipelineLayout ( device , pipelineLayout , nullptr );
         vkDestroyRenderPass ( device , renderPass , nullptr );
 
+        // clean up descriptor pools and set layouts
+        for ( auto& allocator : frameDescriptors )
+        {
+            allocator.Destroy ();
+        }
+        objectUniforms.Destroy ();
+        frameReadback.Destroy ();
+        drawBindings.Destroy ();
+        bindlessTable.Destroy ();
+        JZvk::DestroyBuffer ( device , materialTint );
+        descriptorAllocator.Destroy ();
+        descriptorLayouts.Destroy ();
+
         // clean up image views created by us
         for ( auto imageView : swapChainImageViews )
         {
@@ -1117,7 +2666,14 @@ private:
         }
 
         // cleanup swap chain before device
-        vkDestroySwapchainKHR ( device , swapChain , nullptr );
+        if ( headless )
+        {
+            offscreenTargets.Destroy ();
+        }
+        else
+        {
+            vkDestroySwapchainKHR ( device , swapChain , nullptr );
+        }
 
         vkDestroyDevice(device, nullptr);
 
@@ -1125,17 +2681,24 @@ private:
         if (enableValidationLayers)
         {
             DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+            JZvk::GetValidationSink ().Report ();
         }
 
         // destroy surface, happens before destroy instance
-        vkDestroySurfaceKHR ( instance , surface , nullptr );
+        if ( !headless )
+        {
+            vkDestroySurfaceKHR ( instance , surface , nullptr );
+        }
 
         // destroy vkinstance before program exits
         vkDestroyInstance(instance, nullptr);
 
         // clean up glfw
-        glfwDestroyWindow(window);
-        glfwTerminate();
+        if ( !headless )
+        {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+        }
     }
 
     //void createInstance()
@@ -1296,13 +2859,185 @@ private:
     //}
 };
 
-int main()
+// prints the command line options of main to stderr
+static void PrintUsage ( char const* program )
+{
+    std::cerr << "usage: " << program << " [options]\n"
+        << "  --bench <name>                runs one of the in-app benchmarks instead of the main loop\n"
+        << "  --present <policy>            lowlatency, vsync, adaptive or uncapped for throughput runs\n"
+        << "  --headless                    renders offscreen without a window\n"
+        << "  --frames <n>                  frames rendered headless, or measured by --bench frames\n"
+        << "  --warmup <n>                  unmeasured frames before --bench frames measures\n"
+        << "  --json <path>                 --bench frames report, stdout without it\n"
+        << "  --capture <path>              writes every frame\n"
+        << "  --capture-format <format>     raw, ppm or png\n"
+        << "  --capture-depth <n>           slots of the readback ring\n"
+        << "  --dynamic-resolution <ms>     scales the render resolution to keep gpu frame time under ms\n"
+        << "  --device <index|name>         pins a physical device, as does the JZVK_DEVICE environment variable\n"
+        << "  --validation <severity>       lowest validation message severity reported, verbose, info, warning or error\n"
+        << "  --trace <path>                where builds with JZVK_PROFILING write the chrome trace at exit, T writes it on demand\n"
+        << "  --resolution <w>x<h>          window or offscreen size\n"
+        << "  --frames-in-flight <n>        frames recorded ahead, 1 to " << MAX_FRAMES_IN_FLIGHT << "\n"
+        << "  --scene <kind>                single, grid, scatter or overdraw\n"
+        << "  --scene-size <n>              objects of a generated scene\n"
+        << "  --object-ring                 binds per object data with dynamic uniform buffer offsets instead of push constants\n";
+}
+
+// unsigned decimal in [minimum, maximum], the whole of text. strtoul alone accepts "", "12abc" and wraps "-1"
+static bool ParseCount ( char const* text , uint32_t minimum , uint32_t maximum , uint32_t& out )
+{
+    if ( *text < '0' || *text > '9' )
+    {
+        return false;
+    }
+    char* end = nullptr;
+    unsigned long const value = std::strtoul ( text , &end , 10 );
+    if ( *end != '\0' || value < minimum || value > maximum )
+    {
+        return false;
+    }
+    out = static_cast< uint32_t >( value );
+    return true;
+}
+
+int main( int argc , char** argv )
 {
     HelloTriangleApplication app;
 
+    // see PrintUsage for the options, an unknown option or a malformed value exits with the usage text
+    AppOptions options;
+#ifdef JZVK_FRAME_BENCHMARK
+    // VulkanBench, the frame benchmark of a generated grid, headless
+    options.benchmark = "frames";
+    options.headless = true;
+    options.scene = JZvk::Bench::SceneKind::GRID;
+#endif
+    uint32_t const COUNT_MAX = std::numeric_limits< uint32_t >::max ();
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string const option = argv[ i ];
+        if ( option == "--headless" )
+        {
+            options.headless = true;
+            continue;
+        }
+        if ( option == "--object-ring" )
+        {
+            options.objectRing = true;
+            continue;
+        }
+        if ( option == "--help" || option == "-h" )
+        {
+            PrintUsage ( argv[ 0 ] );
+            return EXIT_SUCCESS;
+        }
+
+        // every other option takes a value
+        if ( option.rfind ( "--" , 0 ) != 0 )
+        {
+            std::cerr << "unexpected argument " << option << "\n";
+            PrintUsage ( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+        if ( i + 1 >= argc )
+        {
+            std::cerr << option << " needs a value\n";
+            PrintUsage ( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+        char const* value = argv[ ++i ];
+        bool valid = true;
+
+        if ( option == "--frames" )
+        {
+            valid = ParseCount ( value , 1 , COUNT_MAX , options.headlessFrames );
+        }
+        else if ( option == "--warmup" )
+        {
+            valid = ParseCount ( value , 0 , COUNT_MAX , options.warmupFrames );
+        }
+        else if ( option == "--scene-size" )
+        {
+            valid = ParseCount ( value , 1 , COUNT_MAX , options.sceneSize );
+        }
+        else if ( option == "--capture-depth" )
+        {
+            valid = ParseCount ( value , 1 , COUNT_MAX , options.captureDepth );
+        }
+        else if ( option == "--frames-in-flight" )
+        {
+            valid = ParseCount ( value , 1 , MAX_FRAMES_IN_FLIGHT , options.framesInFlight );
+        }
+        else if ( option == "--resolution" )
+        {
+            // <width>x<height>, both at least 1
+            std::string const text = value;
+            size_t const separator = text.find ( 'x' );
+            valid = separator != std::string::npos
+                && ParseCount ( text.substr ( 0 , separator ).c_str () , 1 , COUNT_MAX , options.resolution.width )
+                && ParseCount ( text.substr ( separator + 1 ).c_str () , 1 , COUNT_MAX , options.resolution.height );
+        }
+        else if ( option == "--dynamic-resolution" )
+        {
+            // target in ms, 0 turns it off
+            char* end = nullptr;
+            options.dynamicResolutionMs = std::strtod ( value , &end );
+            valid = end != value && *end == '\0' && options.dynamicResolutionMs >= 0.0 && std::isfinite ( options.dynamicResolutionMs );
+        }
+        else if ( option == "--capture-format" )
+        {
+            valid = JZvk::ParseCaptureFormat ( value , options.captureFormat );
+        }
+        else if ( option == "--scene" )
+        {
+            valid = JZvk::Bench::ParseSceneKind ( value , options.scene );
+        }
+        else if ( option == "--present" )
+        {
+            valid = JZvk::ParsePresentPolicy ( value , options.presentPolicy );
+        }
+        else if ( option == "--validation" )
+        {
+            valid = JZvk::ParseValidationSeverity ( value , options.validationSeverities );
+        }
+        else if ( option == "--capture" )
+        {
+            options.capturePath = value;
+        }
+        else if ( option == "--device" )
+        {
+            options.device = value;
+        }
+        else if ( option == "--trace" )
+        {
+            options.tracePath = value;
+        }
+        else if ( option == "--bench" )
+        {
+            options.benchmark = value;
+        }
+        else if ( option == "--json" )
+        {
+            options.reportPath = value;
+        }
+        else
+        {
+            std::cerr << "unknown option " << option << "\n";
+            PrintUsage ( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+
+        if ( !valid )
+        {
+            std::cerr << "invalid value " << value << " for " << option << "\n";
+            PrintUsage ( argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
     try
     {
-        app.run();
+        app.run( options );
     }
     catch (const std::exception& e)
     {
@@ -0,0 +1,6 @@
+#version 450
+
+// pipelines with JZvk::BindlessTable bound at set 0, see createShaderModules
+#define BINDLESS_MATERIALS
+#include "bindless.glsl"
+#include "material.glsl"
@@ -0,0 +1,17 @@
+// bindless resource tables, see JZvk::BindlessTable
+// materials index them with the texture and buffer indices of their push constants
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (set = 0, binding = 0) uniform sampler2D bindlessTextures[];
+
+layout (set = 0, binding = 1) readonly buffer BindlessBuffer {
+    vec4 data[];
+} bindlessBuffers[];
+
+vec4 bindlessTexture(uint index, vec2 uv) {
+    return texture(bindlessTextures[nonuniformEXT(index)], uv);
+}
+
+vec4 bindlessLoad(uint index, uint element) {
+    return bindlessBuffers[nonuniformEXT(index)].data[element];
+}
@@ -1,3 +1,3 @@
-%~dp0/../../Libraries/vulkan/Bin/glslc.exe shader.vert -o vert.spv
-%~dp0/../../Libraries/vulkan/Bin/glslc.exe shader.frag -o frag.spv
+%~dp0/../../x64/Release/ShaderCompiler.exe %~dp0 -o %~dp0/cache -O none -a %~dp0/shaders.baseline.jzsa
+%~dp0/../../x64/Release/ShaderCompiler.exe %~dp0 -o %~dp0/cache -a %~dp0/shaders.jzsa -e %~dp0/shaders.jzsa.inl
 pause
\ No newline at end of file
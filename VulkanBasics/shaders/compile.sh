@@ -0,0 +1,19 @@
+#!/bin/sh
+# Builds the in-process shader compiler on first use, then compiles every
+# shader in this directory into the content-addressed cache in ./cache
+# and packs the result into shaders.jzsa (and shaders.jzsa.inl to embed).
+# shaders.baseline.jzsa holds the same modules as compiled, neither optimized
+# nor stripped like glslc's default output, for the shadermodules benchmark.
+# Needs shaderc and spirv-tools, e.g. from the Vulkan SDK or libshaderc-dev.
+set -e
+SHADER_DIR="$(cd "$(dirname "$0")" && pwd)"
+TOOL_SOURCE="$SHADER_DIR/../../ShaderCompiler/main.cpp"
+TOOL="$SHADER_DIR/../../ShaderCompiler/ShaderCompiler"
+
+if [ ! -x "$TOOL" ] || [ "$TOOL_SOURCE" -nt "$TOOL" ]; then
+    ${CXX:-c++} -std=c++17 -O2 -pthread ${VULKAN_SDK:+-I"$VULKAN_SDK/include" -L"$VULKAN_SDK/lib"} \
+        "$TOOL_SOURCE" -o "$TOOL" -lshaderc_combined
+fi
+
+"$TOOL" "$SHADER_DIR" -o "$SHADER_DIR/cache" -O none -a "$SHADER_DIR/shaders.baseline.jzsa" "$@"
+"$TOOL" "$SHADER_DIR" -o "$SHADER_DIR/cache" -a "$SHADER_DIR/shaders.jzsa" -e "$SHADER_DIR/shaders.jzsa.inl" "$@"
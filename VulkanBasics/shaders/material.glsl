@@ -0,0 +1,76 @@
+// triangle material shared by shader.frag and bindless.frag, which defines
+// BINDLESS_MATERIALS and includes bindless.glsl first
+
+layout (location = 0) in vec3 fragColor;
+layout (location = 0) out vec4 outColor;
+
+// material feature switches, declared per shader in JZvk::ShaderPermutations
+// and mapped to specialization constants. a SPECIALIZED permutation folds the
+// switches at pipeline creation, otherwise they are read from the push constant
+layout (constant_id = 0) const bool SPECIALIZED = false;
+layout (constant_id = 1) const bool FEATURE_PATTERN = false;
+layout (constant_id = 2) const bool FEATURE_GRADING = false;
+
+// matches MaterialConstants in main.cpp, the indices address the bindless table
+// and are only read by bindless.frag
+layout (push_constant) uniform MaterialConstants {
+    uint flags;
+    uint textureIndex;
+    uint bufferIndex;
+} material;
+
+const uint INVALID_INDEX = 0xFFFFFFFFu;   // JZvk::BindlessTable::INVALID_INDEX
+
+const uint FEATURE_PATTERN_BIT = 1u;
+const uint FEATURE_GRADING_BIT = 2u;
+
+bool featureEnabled(bool specialized, uint bit) {
+    return SPECIALIZED ? specialized : (material.flags & bit) != 0u;
+}
+
+// cheap value noise, summed over octaves for a procedural surface pattern
+float hash(vec2 p) {
+    return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
+}
+
+float noise(vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    vec2 u = f * f * (3.0 - 2.0 * f);
+    return mix(mix(hash(i), hash(i + vec2(1.0, 0.0)), u.x),
+               mix(hash(i + vec2(0.0, 1.0)), hash(i + vec2(1.0, 1.0)), u.x), u.y);
+}
+
+float pattern(vec2 p) {
+    float value = 0.0;
+    float amplitude = 0.5;
+    for (int octave = 0; octave < 6; ++octave) {
+        value += amplitude * noise(p);
+        p *= 2.0;
+        amplitude *= 0.5;
+    }
+    return value;
+}
+
+void main() {
+    vec3 color = fragColor;
+
+    if (featureEnabled(FEATURE_PATTERN, FEATURE_PATTERN_BIT)) {
+        color *= 0.5 + pattern(gl_FragCoord.xy * 0.02);
+    }
+
+    if (featureEnabled(FEATURE_GRADING, FEATURE_GRADING_BIT)) {
+        // filmic curve followed by a slight warm tint
+        color = (color * (2.51 * color + 0.03)) / (color * (2.43 * color + 0.59) + 0.14);
+        color *= vec3(1.05, 1.0, 0.95);
+    }
+
+#ifdef BINDLESS_MATERIALS
+    // tint stored in the material's buffer, fetched by its index in the table
+    if (material.bufferIndex != INVALID_INDEX) {
+        color *= bindlessLoad(material.bufferIndex, 0u).rgb;
+    }
+#endif
+
+    outColor = vec4(color, 1.0);
+}
@@ -1,8 +1,4 @@
 #version 450
 
-layout (location = 0) in vec3 fragColor;
-layout (location = 0) out vec4 outColor;
-
-void main() {
-    outColor = vec4(fragColor, 1.0);
-}
\ No newline at end of file
+// pipelines without a bindless table, set 0 is empty
+#include "material.glsl"
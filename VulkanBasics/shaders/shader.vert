@@ -2,6 +2,24 @@
 
 layout (location = 0) out vec3 fragColor;
 
+// per object data, matches ObjectUniforms in main.cpp. JZvk::UniformRing pushes it
+// when it fits in the push constant range, otherwise the draw's slice is bound
+// with a dynamic offset. OBJECT_PUSH_CONSTANTS selects the block that is read
+layout (constant_id = 0) const bool OBJECT_PUSH_CONSTANTS = true;
+
+struct Object {
+    vec4 transform;     // xy offset, zw scale
+};
+
+layout (set = 2, binding = 0) uniform ObjectBlock {
+    Object object;
+} objectUniform;
+
+// offset skips MaterialConstants of shader.frag
+layout (push_constant) uniform ObjectConstants {
+    layout (offset = 16) Object object;
+} objectPush;
+
 vec2 positions[3] = vec2[] (
     vec2(0.0, -0.5),
     vec2(0.5, 0.5),
@@ -15,6 +33,7 @@ vec3 colors[3] = vec3[] (
 );
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    vec4 transform = OBJECT_PUSH_CONSTANTS ? objectPush.object.transform : objectUniform.object.transform;
+    gl_Position = vec4(positions[gl_VertexIndex] * transform.zw + transform.xy, 0.0, 1.0);
     fragColor = colors[gl_VertexIndex];
-}
\ No newline at end of file
+}
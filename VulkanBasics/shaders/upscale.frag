@@ -0,0 +1,17 @@
+#version 450
+
+layout (location = 0) in vec2 screenUV;
+layout (location = 0) out vec4 outColor;
+
+// scene rendered into the top left of a larger target
+layout (set = 0, binding = 0) uniform sampler2D scene;
+
+// matches UpscaleConstants in JZvk_DynamicResolution.cpp
+layout (push_constant) uniform UpscaleConstants {
+    vec2 uvScale;   // render extent over target extent
+    vec2 uvMax;     // half a texel inside the render extent, bilinear taps never reach past it
+} upscale;
+
+void main() {
+    outColor = texture(scene, min(screenUV * upscale.uvScale, upscale.uvMax));
+}
@@ -0,0 +1,9 @@
+#version 450
+
+// fullscreen triangle for JZvk::DynamicResolution, no vertex data
+layout (location = 0) out vec2 screenUV;
+
+void main() {
+    screenUV = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(screenUV * 2.0 - 1.0, 0.0, 1.0);
+}
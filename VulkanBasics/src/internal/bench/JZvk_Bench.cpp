@@ -0,0 +1,82 @@
+#include "JZvk_Bench.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <ostream>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		double Result::Mean () const
+		{
+			if ( samples_ms_.empty () )
+			{
+				return 0.0;
+			}
+			return std::accumulate ( samples_ms_.begin () , samples_ms_.end () , 0.0 ) / static_cast< double >( samples_ms_.size () );
+		}
+
+		double Result::Percentile ( double p ) const
+		{
+			if ( samples_ms_.empty () )
+			{
+				return 0.0;
+			}
+			std::vector<double> sorted = samples_ms_;
+			std::sort ( sorted.begin () , sorted.end () );
+			size_t const rank = static_cast< size_t >( std::ceil ( p * static_cast< double >( sorted.size () ) ) );
+			return sorted[ std::min ( sorted.size () - 1 , rank == 0 ? 0 : rank - 1 ) ];
+		}
+
+		void Report ( std::string const& title , std::vector<Result> const& results )
+		{
+			std::printf ( "%s\n" , title.c_str () );
+			std::printf ( "  %-40s %10s %10s %10s %10s\n" , "case" , "mean ms" , "p50 ms" , "p95 ms" , "p99 ms" );
+			for ( auto const& result : results )
+			{
+				std::printf ( "  %-40s %10.4f %10.4f %10.4f %10.4f\n" , result.name_.c_str () ,
+							  result.Mean () , result.Percentile ( 0.50 ) , result.Percentile ( 0.95 ) , result.Percentile ( 0.99 ) );
+			}
+		}
+
+		void WriteJson ( std::ostream& out , Result const& result )
+		{
+			auto const [ min , max ] = std::minmax_element ( result.samples_ms_.begin () , result.samples_ms_.end () );
+			bool const empty = result.samples_ms_.empty ();
+			out << "{ \"samples\": " << result.samples_ms_.size ()
+				<< ", \"mean_ms\": " << result.Mean ()
+				<< ", \"min_ms\": " << ( empty ? 0.0 : *min )
+				<< ", \"max_ms\": " << ( empty ? 0.0 : *max )
+				<< ", \"p50_ms\": " << result.Percentile ( 0.50 )
+				<< ", \"p95_ms\": " << result.Percentile ( 0.95 )
+				<< ", \"p99_ms\": " << result.Percentile ( 0.99 ) << " }";
+		}
+
+		void WriteJsonString ( std::ostream& out , char const* text )
+		{
+			static char const HEX[] = "0123456789abcdef";
+			out << '"';
+			for ( ; *text != '\0'; ++text )
+			{
+				unsigned char const c = static_cast< unsigned char >( *text );
+				if ( c == '"' || c == '\\' )
+				{
+					out << '\\' << *text;
+				}
+				else if ( c < 0x20 )
+				{
+					out << "\\u00" << HEX[ c >> 4 ] << HEX[ c & 0xf ];
+				}
+				else
+				{
+					out << *text;
+				}
+			}
+			out << '"';
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/* SMALL HARNESS FOR THE IN-APP BENCHMARKS */
+#pragma once
+
+/* STD INCLUDES */
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		struct Result
+		{
+			std::string name_;
+			std::vector<double> samples_ms_;
+
+			double Mean () const;
+			// p in [0,1], nearest rank
+			double Percentile ( double p ) const;
+		};
+
+		/*!
+		 * @brief ___JZvk::Bench::Measure()___
+		 * **************************************************************
+		 * Runs function warmup times untimed, then iterations times,
+		 * recording the wall clock time of each run.
+		 * **************************************************************
+		*/
+		template <typename FUNCTION>
+		Result Measure ( std::string const& name , int warmup , int iterations , FUNCTION&& function )
+		{
+			for ( int i = 0; i < warmup; ++i )
+			{
+				function ();
+			}
+
+			Result result { name , {} };
+			result.samples_ms_.reserve ( static_cast< size_t >( iterations ) );
+			for ( int i = 0; i < iterations; ++i )
+			{
+				auto const start = std::chrono::steady_clock::now ();
+				function ();
+				result.samples_ms_.push_back ( std::chrono::duration<double , std::milli> ( std::chrono::steady_clock::now () - start ).count () );
+			}
+			return result;
+		}
+
+		// prints mean and percentiles of each result as a table to stdout
+		void Report ( std::string const& title , std::vector<Result> const& results );
+
+		// one JSON object of sample count, mean, min, max, p50, p95 and p99 in ms
+		void WriteJson ( std::ostream& out , Result const& result );
+
+		// text as a quoted JSON string, escaping quotes, backslashes and control characters
+		void WriteJsonString ( std::ostream& out , char const* text );
+	}
+}
@@ -0,0 +1,113 @@
+#include "JZvk_Histogram.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		Histogram::Histogram ( double bucketMs , size_t bucketCount )
+			: bucket_ms_ ( bucketMs ) ,
+			buckets_ ( std::max<size_t> ( 1 , bucketCount ) , 0 )
+		{
+		}
+
+		void Histogram::Record ( double ms )
+		{
+			size_t const bucket = ms <= 0.0 ? 0 : static_cast< size_t >( ms / bucket_ms_ );
+			++buckets_[ std::min ( bucket , buckets_.size () - 1 ) ];
+			++count_;
+			sum_ms_ += ms;
+			max_ms_ = std::max ( max_ms_ , ms );
+		}
+
+		void Histogram::Reset ()
+		{
+			std::fill ( buckets_.begin () , buckets_.end () , 0 );
+			count_ = 0;
+			sum_ms_ = 0.0;
+			max_ms_ = 0.0;
+		}
+
+		uint64_t Histogram::Count () const
+		{
+			return count_;
+		}
+
+		double Histogram::Mean () const
+		{
+			return count_ == 0 ? 0.0 : sum_ms_ / static_cast< double >( count_ );
+		}
+
+		double Histogram::Max () const
+		{
+			return max_ms_;
+		}
+
+		double Histogram::Percentile ( double p ) const
+		{
+			if ( count_ == 0 )
+			{
+				return 0.0;
+			}
+			uint64_t const rank = std::max<uint64_t> ( 1 , static_cast< uint64_t >( std::ceil ( p * static_cast< double >( count_ ) ) ) );
+			uint64_t seen { 0 };
+			for ( size_t i = 0; i < buckets_.size (); ++i )
+			{
+				seen += buckets_[ i ];
+				if ( seen >= rank )
+				{
+					// the overflow bucket has no upper edge
+					return i + 1 == buckets_.size () ? max_ms_ : static_cast< double >( i + 1 ) * bucket_ms_;
+				}
+			}
+			return max_ms_;
+		}
+
+		void Histogram::Print ( std::string const& title , size_t rows ) const
+		{
+			std::printf ( "%s\n" , title.c_str () );
+			std::printf ( "  %llu samples, mean %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n" ,
+						  static_cast< unsigned long long >( count_ ) , Mean () , Percentile ( 0.50 ) , Percentile ( 0.95 ) , Percentile ( 0.99 ) , Max () );
+			if ( count_ == 0 )
+			{
+				return;
+			}
+
+			// groups of buckets up to the last one in use
+			size_t used = buckets_.size ();
+			while ( used > 0 && buckets_[ used - 1 ] == 0 )
+			{
+				--used;
+			}
+			size_t const group = ( used + std::max<size_t> ( 1 , rows ) - 1 ) / std::max<size_t> ( 1 , rows );
+
+			std::vector<uint64_t> counts;
+			for ( size_t first = 0; first < used; first += group )
+			{
+				uint64_t count { 0 };
+				for ( size_t i = first; i < std::min ( used , first + group ); ++i )
+				{
+					count += buckets_[ i ];
+				}
+				counts.push_back ( count );
+			}
+
+			uint64_t const largest = *std::max_element ( counts.begin () , counts.end () );
+			for ( size_t i = 0; i < counts.size (); ++i )
+			{
+				if ( counts[ i ] == 0 )
+				{
+					continue;
+				}
+				double const low = static_cast< double >( i * group ) * bucket_ms_;
+				double const high = static_cast< double >( ( i + 1 ) * group ) * bucket_ms_;
+				std::string const bar ( static_cast< size_t >( 40 * counts[ i ] / largest ) , '#' );
+				std::printf ( "  %8.2f - %8.2f ms %10llu %s\n" , low , high , static_cast< unsigned long long >( counts[ i ] ) , bar.c_str () );
+			}
+		}
+	}
+}
@@ -0,0 +1,49 @@
+/* FIXED BUCKET HISTOGRAM FOR LONG RUNNING TIMINGS */
+#pragma once
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		/*!
+		 * @brief ___JZvk::Bench::Histogram___
+		 * **************************************************************
+		 * Millisecond timings binned into fixed width buckets, for
+		 * measurements taken every frame where Result would keep
+		 * growing. The last bucket also collects everything past the
+		 * range, percentiles are accurate to one bucket width.
+		 * **************************************************************
+		*/
+		class Histogram
+		{
+		public:
+			explicit Histogram ( double bucketMs = 0.25 , size_t bucketCount = 400 );
+
+			void Record ( double ms );
+
+			void Reset ();
+
+			uint64_t Count () const;
+			double Mean () const;
+			double Max () const;
+
+			// p in [0,1], upper edge of the bucket holding that rank
+			double Percentile ( double p ) const;
+
+			// summary line and a bar per bucket group, at most rows groups
+			void Print ( std::string const& title , size_t rows = 16 ) const;
+
+		private:
+			double bucket_ms_;
+			std::vector<uint64_t> buckets_;
+			uint64_t count_ { 0 };
+			double sum_ms_ { 0.0 };
+			double max_ms_ { 0.0 };
+		};
+	}
+}
@@ -0,0 +1,100 @@
+#include "JZvk_SceneGenerator.h"
+
+/* STD INCLUDES */
+#include <cmath>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		// xorshift32, std distributions are not required to give the same values across standard libraries
+		static float NextUnit ( uint32_t& state )
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return static_cast< float >( state >> 8 ) / static_cast< float >( 1u << 24 );
+		}
+
+		std::vector<ObjectTransform> GenerateScene ( SceneKind kind , uint32_t count , uint32_t seed )
+		{
+			std::vector<ObjectTransform> transforms;
+			if ( kind == SceneKind::SINGLE || count == 0 )
+			{
+				transforms.push_back ( { 0.0f , 0.0f , 1.0f , 1.0f } );
+				return transforms;
+			}
+			transforms.reserve ( count );
+
+			// zero would stay zero
+			uint32_t state = seed == 0 ? 1 : seed;
+			switch ( kind )
+			{
+			case SceneKind::GRID:
+			{
+				// the triangle spans a unit square, a cell of clip space is 2 / columns wide
+				uint32_t const columns = static_cast< uint32_t >( std::ceil ( std::sqrt ( static_cast< double >( count ) ) ) );
+				float const cell = 2.0f / static_cast< float >( columns );
+				for ( uint32_t i = 0; i < count; ++i )
+				{
+					float const x = -1.0f + cell * ( static_cast< float >( i % columns ) + 0.5f );
+					float const y = -1.0f + cell * ( static_cast< float >( i / columns ) + 0.5f );
+					transforms.push_back ( { x , y , cell , cell } );
+				}
+				break;
+			}
+			case SceneKind::SCATTER:
+				for ( uint32_t i = 0; i < count; ++i )
+				{
+					float const x = NextUnit ( state ) * 2.0f - 1.0f;
+					float const y = NextUnit ( state ) * 2.0f - 1.0f;
+					float const scale = 0.05f + NextUnit ( state ) * 0.35f;
+					transforms.push_back ( { x , y , scale , scale } );
+				}
+				break;
+			case SceneKind::OVERDRAW:
+				// a triangle scaled by 6 just reaches the corners of clip space, jittered so no two are identical
+				for ( uint32_t i = 0; i < count; ++i )
+				{
+					float const x = ( NextUnit ( state ) - 0.5f ) * 0.1f;
+					float const y = ( NextUnit ( state ) - 0.5f ) * 0.1f;
+					transforms.push_back ( { x , y , 6.5f , 6.5f } );
+				}
+				break;
+			default:
+				break;
+			}
+			return transforms;
+		}
+
+		char const* SceneKindName ( SceneKind kind )
+		{
+			switch ( kind )
+			{
+			case SceneKind::SINGLE:
+				return "single";
+			case SceneKind::GRID:
+				return "grid";
+			case SceneKind::SCATTER:
+				return "scatter";
+			case SceneKind::OVERDRAW:
+				return "overdraw";
+			default:
+				return "unknown";
+			}
+		}
+
+		bool ParseSceneKind ( std::string const& name , SceneKind& kind )
+		{
+			for ( int i = 0; i < static_cast< int >( SceneKind::COUNT ); ++i )
+			{
+				if ( name == SceneKindName ( static_cast< SceneKind >( i ) ) )
+				{
+					kind = static_cast< SceneKind >( i );
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+/* PROCEDURALLY GENERATED SCENES FOR THE FRAME BENCHMARK */
+#pragma once
+
+/* STD INCLUDES */
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace JZvk
+{
+	namespace Bench
+	{
+		/*!
+		 * @brief ___JZvk::Bench::SceneKind___
+		 * **************************************************************
+		 * Layout of the generated objects, each a transform of the
+		 * triangle in shader.vert, xy offset and zw scale in clip space.
+		 *
+		 * SINGLE		: one unscaled triangle in the centre, the scene
+		 *				  the app draws without --scene
+		 * GRID			: objects tiled over the screen without overlap,
+		 *				  draw call and vertex bound
+		 * SCATTER		: random offsets and scales, some overlap
+		 * OVERDRAW		: every object covers the whole screen, fill
+		 *				  rate bound
+		 * **************************************************************
+		*/
+		enum class SceneKind
+		{
+			SINGLE ,
+			GRID ,
+			SCATTER ,
+			OVERDRAW ,
+			COUNT
+		};
+
+		using ObjectTransform = std::array<float , 4>;
+
+		/*!
+		 * @brief ___JZvk::Bench::GenerateScene()___
+		 * **************************************************************
+		 * count transforms of kind, the same for the same seed on every
+		 * run and platform. SINGLE ignores count.
+		 * **************************************************************
+		*/
+		std::vector<ObjectTransform> GenerateScene ( SceneKind kind , uint32_t count , uint32_t seed = 1 );
+
+		char const* SceneKindName ( SceneKind kind );
+
+		// case sensitive match of SceneKindName, false if unknown
+		bool ParseSceneKind ( std::string const& name , SceneKind& kind );
+	}
+}
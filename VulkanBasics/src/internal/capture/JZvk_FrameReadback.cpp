@@ -0,0 +1,391 @@
+#include "JZvk_FrameReadback.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cstdio>
+
+namespace JZvk
+{
+	static uint32_t Crc32 ( uint8_t const* data , size_t size , uint32_t crc = 0 )
+	{
+		static uint32_t table[ 256 ] = {};
+		if ( table[ 1 ] == 0 )
+		{
+			for ( uint32_t i = 0; i < 256; ++i )
+			{
+				uint32_t value = i;
+				for ( int bit = 0; bit < 8; ++bit )
+				{
+					value = ( value & 1 ) ? 0xEDB88320u ^ ( value >> 1 ) : value >> 1;
+				}
+				table[ i ] = value;
+			}
+		}
+		crc = ~crc;
+		for ( size_t i = 0; i < size; ++i )
+		{
+			crc = table[ ( crc ^ data[ i ] ) & 0xFF ] ^ ( crc >> 8 );
+		}
+		return ~crc;
+	}
+
+	static void PutBigEndian ( std::vector<uint8_t>& out , uint32_t value )
+	{
+		out.push_back ( static_cast< uint8_t >( value >> 24 ) );
+		out.push_back ( static_cast< uint8_t >( value >> 16 ) );
+		out.push_back ( static_cast< uint8_t >( value >> 8 ) );
+		out.push_back ( static_cast< uint8_t >( value ) );
+	}
+
+	static void PutChunk ( std::vector<uint8_t>& out , char const* type , std::vector<uint8_t> const& data )
+	{
+		PutBigEndian ( out , static_cast< uint32_t >( data.size () ) );
+		size_t const start = out.size ();
+		out.insert ( out.end () , type , type + 4 );
+		out.insert ( out.end () , data.begin () , data.end () );
+		PutBigEndian ( out , Crc32 ( out.data () + start , out.size () - start ) );
+	}
+
+	// uncompressed png, the zlib stream is made of stored deflate blocks so no compressor is needed
+	static void EncodePNG ( std::vector<uint8_t> const& rgb , uint32_t width , uint32_t height , std::vector<uint8_t>& out )
+	{
+		static uint8_t const signature[] = { 0x89 , 'P' , 'N' , 'G' , '\r' , '\n' , 0x1A , '\n' };
+		out.assign ( signature , signature + sizeof ( signature ) );
+
+		std::vector<uint8_t> header;
+		PutBigEndian ( header , width );
+		PutBigEndian ( header , height );
+		// 8 bit rgb, deflate, adaptive filtering, no interlace
+		header.insert ( header.end () , { 8 , 2 , 0 , 0 , 0 } );
+		PutChunk ( out , "IHDR" , header );
+
+		// every scanline is prefixed with filter type 0
+		size_t const row_size = static_cast< size_t >( width ) * 3;
+		std::vector<uint8_t> scanlines;
+		scanlines.reserve ( ( row_size + 1 ) * height );
+		for ( uint32_t y = 0; y < height; ++y )
+		{
+			scanlines.push_back ( 0 );
+			scanlines.insert ( scanlines.end () , rgb.begin () + y * row_size , rgb.begin () + ( y + 1 ) * row_size );
+		}
+
+		std::vector<uint8_t> zlib = { 0x78 , 0x01 };
+		size_t const max_block = 65535;
+		for ( size_t offset = 0; offset < scanlines.size () || offset == 0; offset += max_block )
+		{
+			size_t const size = std::min ( max_block , scanlines.size () - offset );
+			bool const last = offset + size >= scanlines.size ();
+			zlib.push_back ( last ? 1 : 0 );
+			zlib.push_back ( static_cast< uint8_t >( size ) );
+			zlib.push_back ( static_cast< uint8_t >( size >> 8 ) );
+			zlib.push_back ( static_cast< uint8_t >( ~size ) );
+			zlib.push_back ( static_cast< uint8_t >( ~size >> 8 ) );
+			zlib.insert ( zlib.end () , scanlines.begin () + offset , scanlines.begin () + offset + size );
+			if ( last )
+			{
+				break;
+			}
+		}
+
+		uint32_t a = 1 , b = 0;
+		for ( auto const byte : scanlines )
+		{
+			a = ( a + byte ) % 65521;
+			b = ( b + a ) % 65521;
+		}
+		PutBigEndian ( zlib , ( b << 16 ) | a );
+
+		PutChunk ( out , "IDAT" , zlib );
+		PutChunk ( out , "IEND" , {} );
+	}
+
+	bool ParseCaptureFormat ( std::string const& name , CaptureFormat& format )
+	{
+		if ( name == "raw" )
+		{
+			format = CaptureFormat::RAW;
+		}
+		else if ( name == "ppm" )
+		{
+			format = CaptureFormat::PPM;
+		}
+		else if ( name == "png" )
+		{
+			format = CaptureFormat::PNG;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	bool FrameReadback::Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkExtent2D extent , VkFormat format ,
+									 uint32_t depth , std::string const& path , CaptureFormat captureFormat )
+	{
+		logical_device_ = logicalDevice;
+		extent_ = extent;
+		path_ = path;
+		format_ = captureFormat;
+
+		switch ( format )
+		{
+		case VK_FORMAT_B8G8R8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+			bgra_ = true;
+			break;
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_R8G8B8A8_UNORM:
+			bgra_ = false;
+			break;
+		default:
+			Log ( LOG::ERROR , "Frame readback only handles 4 byte BGRA and RGBA formats." );
+			return false;
+		}
+
+		if ( format_ != CaptureFormat::PNG )
+		{
+			stream_.open ( path_ , std::ios::binary | std::ios::trunc );
+			if ( !stream_ )
+			{
+				Log ( LOG::ERROR , "Failed to open capture stream " , path_ );
+				return false;
+			}
+		}
+
+		// the cpu reads every byte, cached memory is much faster to read where there is some
+		VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+		if ( FindMemoryType ( physicalDevice , ~0u , properties ) == UINT32_MAX )
+		{
+			properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		}
+
+		VkDeviceSize const size = static_cast< VkDeviceSize >( extent.width ) * extent.height * 4;
+		depth_ = std::max ( 1u , depth );
+		slots_ = std::make_unique<Slot[]> ( depth_ );
+		for ( uint32_t i = 0; i < depth_; ++i )
+		{
+			slots_[ i ].buffer_ = Create::VKBuffer ( logicalDevice , physicalDevice , size , VK_BUFFER_USAGE_TRANSFER_DST_BIT , properties );
+			if ( !slots_[ i ].buffer_.mapped_ )
+			{
+				Log ( LOG::ERROR , "Failed to create frame readback buffer." );
+				Destroy ();
+				return false;
+			}
+		}
+
+		stopping_ = false;
+		writer_ = std::thread ( &FrameReadback::WriterLoop , this );
+
+		Log ( LOG::INFO , "FRAME READBACK" );
+		Log ( LOG::INFO , "\t" , depth_ , " slots of " , size , " bytes, writing " , path_ );
+		return true;
+	}
+
+	bool FrameReadback::Enabled () const
+	{
+		return depth_ > 0;
+	}
+
+	VkExtent2D FrameReadback::Extent () const
+	{
+		return extent_;
+	}
+
+	bool FrameReadback::Capture ( VkCommandBuffer commandBuffer , VkImage image , VkImageLayout layout , uint32_t frame )
+	{
+		// slots are taken in order, so the next one is also the oldest
+		Slot& slot = slots_[ next_ ];
+		if ( slot.state_.load ( std::memory_order_acquire ) != FREE )
+		{
+			++dropped_;
+			return false;
+		}
+		next_ = ( next_ + 1 ) % depth_;
+		slot.state_.store ( IN_FLIGHT , std::memory_order_relaxed );
+		slot.frame_ = frame;
+		slot.sequence_ = sequence_++;
+
+		// the render pass leaves the image without a dependency on anything after it
+		VkImageMemoryBarrier to_transfer {};
+		to_transfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		to_transfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		to_transfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		to_transfer.oldLayout = layout;
+		to_transfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		to_transfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		to_transfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		to_transfer.image = image;
+		to_transfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT , 0 , 1 , 0 , 1 };
+		Dispatch ().CmdPipelineBarrier ( commandBuffer , VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT , VK_PIPELINE_STAGE_TRANSFER_BIT , 0 ,
+							   0 , nullptr , 0 , nullptr , 1 , &to_transfer );
+
+		VkBufferImageCopy region {};
+		region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT , 0 , 0 , 1 };
+		region.imageExtent = { extent_.width , extent_.height , 1 };
+		Dispatch ().CmdCopyImageToBuffer ( commandBuffer , image , VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL , slot.buffer_.buffer_ , 1 , &region );
+
+		// makes the copy available to the host once the fence signals
+		VkBufferMemoryBarrier to_host {};
+		to_host.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		to_host.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		to_host.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		to_host.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		to_host.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		to_host.buffer = slot.buffer_.buffer_;
+		to_host.size = VK_WHOLE_SIZE;
+
+		// and gives the image back in the layout it came in, e.g. for presenting
+		VkImageMemoryBarrier to_layout = to_transfer;
+		to_layout.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		to_layout.dstAccessMask = 0;
+		to_layout.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		to_layout.newLayout = layout;
+		uint32_t const image_barriers = layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ? 0 : 1;
+		Dispatch ().CmdPipelineBarrier ( commandBuffer , VK_PIPELINE_STAGE_TRANSFER_BIT , VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT , 0 ,
+							   0 , nullptr , 1 , &to_host , image_barriers , &to_layout );
+		return true;
+	}
+
+	void FrameReadback::Retire ( uint32_t frame )
+	{
+		// oldest first, keeps the output in frame order
+		std::vector<Slot*> retired;
+		for ( uint32_t i = 0; i < depth_; ++i )
+		{
+			Slot& slot = slots_[ ( next_ + i ) % depth_ ];
+			if ( slot.state_.load ( std::memory_order_relaxed ) == IN_FLIGHT && slot.frame_ == frame )
+			{
+				slot.state_.store ( WRITING , std::memory_order_relaxed );
+				retired.push_back ( &slot );
+			}
+		}
+		if ( retired.empty () )
+		{
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock ( mutex_ );
+			queue_.insert ( queue_.end () , retired.begin () , retired.end () );
+		}
+		ready_.notify_one ();
+	}
+
+	uint64_t FrameReadback::Written () const
+	{
+		return written_.load ();
+	}
+
+	uint64_t FrameReadback::Dropped () const
+	{
+		return dropped_;
+	}
+
+	void FrameReadback::WriterLoop ()
+	{
+		std::vector<uint8_t> rgb;
+		for ( ;; )
+		{
+			Slot* slot { nullptr };
+			{
+				std::unique_lock<std::mutex> lock ( mutex_ );
+				ready_.wait ( lock , [ this ] () { return stopping_ || !queue_.empty (); } );
+				if ( queue_.empty () )
+				{
+					return;
+				}
+				slot = queue_.front ();
+				queue_.pop_front ();
+			}
+
+			Write ( *slot , rgb );
+			++written_;
+			slot->state_.store ( FREE , std::memory_order_release );
+		}
+	}
+
+	void FrameReadback::Write ( Slot const& slot , std::vector<uint8_t>& rgb )
+	{
+		// no-op on coherent memory, required on cached memory that is not
+		VkMappedMemoryRange range {};
+		range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		range.memory = slot.buffer_.memory_;
+		range.size = VK_WHOLE_SIZE;
+		vkInvalidateMappedMemoryRanges ( logical_device_ , 1 , &range );
+
+		size_t const pixels = static_cast< size_t >( extent_.width ) * extent_.height;
+		uint8_t const* source = static_cast< uint8_t const* >( slot.buffer_.mapped_ );
+		rgb.resize ( pixels * 3 );
+		int const red = bgra_ ? 2 : 0;
+		int const blue = bgra_ ? 0 : 2;
+		for ( size_t i = 0; i < pixels; ++i )
+		{
+			rgb[ i * 3 + 0 ] = source[ i * 4 + red ];
+			rgb[ i * 3 + 1 ] = source[ i * 4 + 1 ];
+			rgb[ i * 3 + 2 ] = source[ i * 4 + blue ];
+		}
+
+		switch ( format_ )
+		{
+		case CaptureFormat::PPM:
+			stream_ << "P6\n" << extent_.width << " " << extent_.height << "\n255\n";
+			stream_.write ( reinterpret_cast< char const* >( rgb.data () ) , static_cast< std::streamsize >( rgb.size () ) );
+			break;
+		case CaptureFormat::PNG:
+		{
+			char suffix[ 32 ];
+			std::snprintf ( suffix , sizeof ( suffix ) , "_%06llu.png" , static_cast< unsigned long long >( slot.sequence_ ) );
+			std::vector<uint8_t> png;
+			EncodePNG ( rgb , extent_.width , extent_.height , png );
+			std::ofstream file ( path_ + suffix , std::ios::binary | std::ios::trunc );
+			file.write ( reinterpret_cast< char const* >( png.data () ) , static_cast< std::streamsize >( png.size () ) );
+			break;
+		}
+		default:
+			stream_.write ( reinterpret_cast< char const* >( rgb.data () ) , static_cast< std::streamsize >( rgb.size () ) );
+			break;
+		}
+	}
+
+	void FrameReadback::Destroy ()
+	{
+		// the device is idle, so whatever is still in flight has been copied
+		for ( uint32_t i = 0; i < depth_; ++i )
+		{
+			Retire ( slots_[ i ].frame_ );
+		}
+
+		if ( writer_.joinable () )
+		{
+			{
+				std::lock_guard<std::mutex> lock ( mutex_ );
+				stopping_ = true;
+			}
+			ready_.notify_one ();
+			writer_.join ();
+		}
+		else
+		{
+			// initialization failed before the writer started, nothing was queued to it
+			std::lock_guard<std::mutex> lock ( mutex_ );
+			queue_.clear ();
+		}
+
+		for ( uint32_t i = 0; i < depth_; ++i )
+		{
+			DestroyBuffer ( logical_device_ , slots_[ i ].buffer_ );
+		}
+		if ( depth_ > 0 )
+		{
+			Log ( LOG::INFO , "FRAME READBACK" );
+			Log ( LOG::INFO , "\t" , written_.load () , " frames written, " , dropped_ , " dropped" );
+		}
+		slots_.reset ();
+		depth_ = 0;
+		stream_.close ();
+	}
+}
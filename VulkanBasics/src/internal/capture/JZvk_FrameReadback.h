@@ -0,0 +1,113 @@
+/* ASYNCHRONOUS READBACK OF RENDERED FRAMES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../memory/JZvk_Buffer.h"
+
+/* STD INCLUDES */
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace JZvk
+{
+	enum class CaptureFormat
+	{
+		RAW ,	// one stream of packed RGB8 frames, e.g. ffmpeg -f rawvideo -pix_fmt rgb24
+		PPM ,	// one stream of binary PPM images, e.g. ffmpeg -f image2pipe -c:v ppm
+		PNG		// a file per frame, path_000000.png onwards
+	};
+
+	// raw, ppm or png, false if unknown
+	bool ParseCaptureFormat ( std::string const& name , CaptureFormat& format );
+
+	/*!
+	 * @brief ___JZvk::FrameReadback___
+	 * **************************************************************
+	 * Ring of host visible buffers that rendered images are copied
+	 * into with vkCmdCopyImageToBuffer, at the end of the frame's
+	 * own command buffer. A slot is only read once the fence of the
+	 * frame that wrote it has signaled, see Retire(), and is then
+	 * handed to a background thread that converts it to RGB8 and
+	 * writes it out. The slot returns to the ring once written.
+	 *
+	 * Rendering never waits on readback, a frame that finds no free
+	 * slot is dropped and counted instead. The ring should be deeper
+	 * than the frames in flight to leave the writer some slack.
+	 *
+	 * Images are 4 byte BGRA or RGBA formats.
+	 * **************************************************************
+	*/
+	class FrameReadback
+	{
+	public:
+		bool Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkExtent2D extent , VkFormat format ,
+						  uint32_t depth , std::string const& path , CaptureFormat captureFormat );
+
+		bool Enabled () const;
+
+		// of the images Capture() expects, fixed at Initialize()
+		VkExtent2D Extent () const;
+
+		// records the copy of image, left in layout by the render pass and put back into it afterwards
+		// false when every slot is busy and the frame is dropped
+		bool Capture ( VkCommandBuffer commandBuffer , VkImage image , VkImageLayout layout , uint32_t frame );
+
+		// call once the fence of frame has been waited on, queues its copies for writing
+		void Retire ( uint32_t frame );
+
+		uint64_t Written () const;
+		uint64_t Dropped () const;
+
+		// the device must be idle, waits for the writer to finish what is queued
+		void Destroy ();
+
+	private:
+		enum SlotState : uint32_t
+		{
+			FREE ,
+			IN_FLIGHT ,		// copy submitted, fence not yet waited on
+			WRITING			// owned by the writer thread
+		};
+
+		struct Slot
+		{
+			Buffer buffer_;
+			std::atomic<uint32_t> state_ { FREE };
+			uint32_t frame_ { 0 };
+			uint64_t sequence_ { 0 };
+		};
+
+		void WriterLoop ();
+		void Write ( Slot const& slot , std::vector<uint8_t>& rgb );
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkExtent2D extent_ { 0 , 0 };
+		bool bgra_ { true };
+		std::string path_;
+		CaptureFormat format_ { CaptureFormat::RAW };
+		std::ofstream stream_;
+
+		std::unique_ptr<Slot[]> slots_;
+		uint32_t depth_ { 0 };
+		uint32_t next_ { 0 };
+		uint64_t sequence_ { 0 };
+		uint64_t dropped_ { 0 };
+		std::atomic<uint64_t> written_ { 0 };
+
+		std::thread writer_;
+		std::mutex mutex_;
+		std::condition_variable ready_;
+		std::deque<Slot*> queue_;
+		bool stopping_ { false };
+	};
+}
@@ -0,0 +1,212 @@
+#include "JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace JZvk
+{
+	namespace LogRing
+	{
+		// power of two, a full ring makes producers wait
+		static constexpr uint64_t CAPACITY = 4096;
+
+		/*!
+		 * @brief ___JZvk::LogRing::Ring___
+		 * **************************************************************
+		 * Bounded queue of sequenced records. A record is free for the
+		 * producer claiming position p when its sequence is p, ready
+		 * for the writer when it is p + 1, and handed back for p +
+		 * CAPACITY once written. Producers only contend on one atomic
+		 * increment, the writer sleeps when idle and is woken by the
+		 * producer that finds it asleep.
+		 * **************************************************************
+		*/
+		struct Ring
+		{
+			Ring ()
+				: records_ { new Record[ CAPACITY ] }
+			{
+				for ( uint64_t i = 0; i < CAPACITY; ++i )
+				{
+					records_[ i ].sequence_.store ( i , std::memory_order_relaxed );
+				}
+				writer_ = std::thread ( &Ring::WriterLoop , this );
+			}
+
+			~Ring ()
+			{
+				{
+					std::lock_guard<std::mutex> lock ( mutex_ );
+					stop_ = true;
+				}
+				wake_.notify_one ();
+				writer_.join ();
+			}
+
+			void Wake ()
+			{
+				if ( sleeping_.load () )
+				{
+					std::lock_guard<std::mutex> lock ( mutex_ );
+					wake_.notify_one ();
+				}
+			}
+
+			bool Ready () const
+			{
+				return records_[ read_ & ( CAPACITY - 1 ) ].sequence_.load ( std::memory_order_acquire ) == read_ + 1;
+			}
+
+			// writes every ready record, switching streams flushes the previous one
+			bool Drain ()
+			{
+				if ( !Ready () )
+				{
+					return false;
+				}
+
+				std::string text;
+				std::FILE* stream = nullptr;
+				auto write = [ & ] ()
+				{
+					if ( stream != nullptr && !text.empty () && !muted_.load ( std::memory_order_relaxed ) )
+					{
+						std::fwrite ( text.data () , 1 , text.size () , stream );
+						std::fflush ( stream );
+					}
+					text.clear ();
+				};
+
+				while ( Ready () )
+				{
+					Record& record = records_[ read_ & ( CAPACITY - 1 ) ];
+					std::FILE* const record_stream = record.level_ == LOG::INFO.value ? stdout : stderr;
+					if ( record_stream != stream )
+					{
+						write ();
+						stream = record_stream;
+					}
+					if ( record.level_ == LOG::WARNING.value )
+					{
+						text += "WARNING: ";
+					}
+					else if ( record.level_ == LOG::ERROR.value )
+					{
+						text += "ERROR: ";
+					}
+					text.append ( record.text_ , record.length_ );
+					text += '\n';
+
+					record.sequence_.store ( read_ + CAPACITY , std::memory_order_release );
+					++read_;
+				}
+				write ();
+				written_.store ( read_ , std::memory_order_release );
+				return true;
+			}
+
+			void WriterLoop ()
+			{
+				for ( ;; )
+				{
+					if ( Drain () )
+					{
+						continue;
+					}
+
+					std::unique_lock<std::mutex> lock ( mutex_ );
+					if ( stop_ )
+					{
+						lock.unlock ();
+						Drain ();
+						return;
+					}
+					sleeping_.store ( true );
+					// the timeout covers a commit racing the flag
+					if ( !Ready () )
+					{
+						wake_.wait_for ( lock , std::chrono::milliseconds ( 10 ) );
+					}
+					sleeping_.store ( false );
+				}
+			}
+
+			std::unique_ptr<Record[]> records_;
+			alignas( 64 ) std::atomic<uint64_t> write_ { 0 };
+			// only touched by the writer thread
+			alignas( 64 ) uint64_t read_ { 0 };
+			std::atomic<uint64_t> written_ { 0 };
+			std::atomic<bool> sleeping_ { false };
+			std::atomic<bool> muted_ { false };
+
+			std::mutex mutex_;
+			std::condition_variable wake_;
+			bool stop_ { false };
+			std::thread writer_;
+		};
+
+		static Ring& GetRing ()
+		{
+			static Ring ring;
+			return ring;
+		}
+
+		Record& Claim ()
+		{
+			Ring& ring = GetRing ();
+			uint64_t position = ring.write_.load ( std::memory_order_relaxed );
+			for ( ;; )
+			{
+				Record& record = ring.records_[ position & ( CAPACITY - 1 ) ];
+				uint64_t const sequence = record.sequence_.load ( std::memory_order_acquire );
+				if ( sequence == position )
+				{
+					if ( ring.write_.compare_exchange_weak ( position , position + 1 , std::memory_order_relaxed ) )
+					{
+						record.position_ = position;
+						return record;
+					}
+				}
+				else if ( sequence < position )
+				{
+					// full, the writer has not handed this record back yet
+					ring.Wake ();
+					std::this_thread::yield ();
+					position = ring.write_.load ( std::memory_order_relaxed );
+				}
+				else
+				{
+					position = ring.write_.load ( std::memory_order_relaxed );
+				}
+			}
+		}
+
+		void Commit ( Record& record )
+		{
+			record.sequence_.store ( record.position_ + 1 , std::memory_order_release );
+			GetRing ().Wake ();
+		}
+	}
+
+	void FlushLog ()
+	{
+		LogRing::Ring& ring = LogRing::GetRing ();
+		uint64_t const target = ring.write_.load ( std::memory_order_acquire );
+		while ( ring.written_.load ( std::memory_order_acquire ) < target )
+		{
+			ring.Wake ();
+			std::this_thread::yield ();
+		}
+	}
+
+	void SetLogMuted ( bool muted )
+	{
+		LogRing::GetRing ().muted_.store ( muted , std::memory_order_relaxed );
+	}
+}
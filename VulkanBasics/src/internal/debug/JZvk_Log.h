@@ -0,0 +1,129 @@
+/* ASYNCHRONOUS LOGGING THROUGH A LOCK FREE RING */
+#pragma once
+
+/* STD INCLUDES */
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+
+// lowest level that is logged, 0 INFO, 1 WARNING, 2 ERROR, 3 nothing,
+// calls below it compile to nothing (their arguments are still evaluated)
+#ifndef JZVK_LOG_THRESHOLD
+#define JZVK_LOG_THRESHOLD 0
+#endif
+
+namespace JZvk
+{
+	// levels are types so the threshold can discard calls with if constexpr
+	template <int LEVEL>
+	struct LogLevel
+	{
+		static constexpr int value = LEVEL;
+	};
+
+	namespace LOG
+	{
+		inline constexpr LogLevel<0> INFO {};
+		inline constexpr LogLevel<1> WARNING {};
+		inline constexpr LogLevel<2> ERROR {};
+	}
+
+	namespace LogRing
+	{
+		// text past this is cut off, one record is one line
+		constexpr size_t RECORD_TEXT = 240;
+
+		struct Record
+		{
+			std::atomic<uint64_t> sequence_;
+			uint64_t position_;
+			int level_;
+			uint32_t length_;
+			char text_[ RECORD_TEXT ];
+		};
+
+		// takes the next record of the ring, yields while the ring is full
+		Record& Claim ();
+
+		// hands a claimed record to the writer thread
+		void Commit ( Record& record );
+
+		inline void Append ( Record& record , std::string_view text )
+		{
+			size_t const length = text.size () < RECORD_TEXT - record.length_ ? text.size () : RECORD_TEXT - record.length_;
+			std::memcpy ( record.text_ + record.length_ , text.data () , length );
+			record.length_ += static_cast< uint32_t >( length );
+		}
+
+		template <typename TYPE>
+		void Append ( Record& record , TYPE const& value )
+		{
+			if constexpr ( std::is_same_v<TYPE , bool> )
+			{
+				Append ( record , value ? std::string_view ( "true" ) : std::string_view ( "false" ) );
+			}
+			else if constexpr ( std::is_same_v<TYPE , char> )
+			{
+				Append ( record , std::string_view ( &value , 1 ) );
+			}
+			else if constexpr ( std::is_convertible_v<TYPE const& , std::string_view> )
+			{
+				Append ( record , std::string_view ( value ) );
+			}
+			else if constexpr ( std::is_arithmetic_v<TYPE> )
+			{
+				auto const result = std::to_chars ( record.text_ + record.length_ , record.text_ + RECORD_TEXT , value );
+				if ( result.ec == std::errc () )
+				{
+					record.length_ = static_cast< uint32_t >( result.ptr - record.text_ );
+				}
+			}
+			else if constexpr ( std::is_enum_v<TYPE> )
+			{
+				Append ( record , static_cast< std::underlying_type_t<TYPE> >( value ) );
+			}
+			else
+			{
+				// anything else goes through its operator<<, the slow path
+				std::ostringstream stream;
+				stream << value;
+				Append ( record , std::string_view ( stream.str () ) );
+			}
+		}
+	}
+
+	/*!
+	 * @brief ___JZvk::Log()___
+	 * **************************************************************
+	 * Formats args into a record of a lock free multiple producer,
+	 * single consumer ring and returns, a background thread writes
+	 * records in order, INFO to stdout and the rest to stderr.
+	 * Strings, numbers and enums are formatted without streams.
+	 *
+	 * Output written directly to stdout may overtake earlier Log
+	 * calls, call FlushLog() first where the order matters.
+	 * **************************************************************
+	*/
+	template <int LEVEL , typename... ARGS>
+	inline void Log ( LogLevel<LEVEL> , ARGS const&... args )
+	{
+		if constexpr ( LEVEL >= JZVK_LOG_THRESHOLD )
+		{
+			LogRing::Record& record = LogRing::Claim ();
+			record.level_ = LEVEL;
+			record.length_ = 0;
+			( LogRing::Append ( record , args ) , ... );
+			LogRing::Commit ( record );
+		}
+	}
+
+	// blocks until everything logged before the call has been written
+	void FlushLog ();
+
+	// records are still formatted and queued but not written, for benchmarks
+	void SetLogMuted ( bool muted );
+}
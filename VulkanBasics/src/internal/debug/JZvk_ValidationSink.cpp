@@ -0,0 +1,270 @@
+#include "JZvk_ValidationSink.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace JZvk
+{
+	static char const* SeverityName ( VkDebugUtilsMessageSeverityFlagBitsEXT severity )
+	{
+		switch ( severity )
+		{
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
+			return "VERBOSE";
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
+			return "INFO";
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
+			return "WARNING";
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+			return "ERROR";
+		default:
+			return "";
+		}
+	}
+
+	ValidationSink::ValidationSink ()
+		: severities_ { VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT } ,
+		  types_ { VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT }
+	{
+		writer_ = std::thread ( &ValidationSink::Write , this );
+	}
+
+	ValidationSink::~ValidationSink ()
+	{
+		{
+			std::lock_guard<std::mutex> lock ( queue_mutex_ );
+			stop_ = true;
+		}
+		queue_cv_.notify_one ();
+		writer_.join ();
+	}
+
+	void ValidationSink::SetSeverities ( VkDebugUtilsMessageSeverityFlagsEXT severities )
+	{
+		severities_.store ( severities , std::memory_order_relaxed );
+	}
+
+	void ValidationSink::SetTypes ( VkDebugUtilsMessageTypeFlagsEXT types )
+	{
+		types_.store ( types , std::memory_order_relaxed );
+	}
+
+	VkDebugUtilsMessageSeverityFlagsEXT ValidationSink::Severities () const
+	{
+		return severities_.load ( std::memory_order_relaxed );
+	}
+
+	VkDebugUtilsMessageTypeFlagsEXT ValidationSink::Types () const
+	{
+		return types_.load ( std::memory_order_relaxed );
+	}
+
+	void ValidationSink::SetSummaryInterval ( uint32_t frames )
+	{
+		summary_interval_ = std::max ( frames , 1u );
+	}
+
+	void ValidationSink::Submit ( VkDebugUtilsMessageSeverityFlagBitsEXT severity , VkDebugUtilsMessageTypeFlagsEXT type ,
+								  VkDebugUtilsMessengerCallbackDataEXT const& data )
+	{
+		if ( ( Severities () & severity ) == 0 || ( Types () & type ) == 0 )
+		{
+			return;
+		}
+
+		char const* text = data.pMessage != nullptr ? data.pMessage : "";
+
+		// loader and general messages often have no id, their text tells them apart
+		uint64_t const key = data.messageIdNumber != 0
+			? static_cast< uint32_t >( data.messageIdNumber )
+			: std::hash<std::string_view> {} ( text ) | ( uint64_t { 1 } << 63 );
+
+		Output output;
+		{
+			std::lock_guard<std::mutex> lock ( messages_mutex_ );
+			Message& message = messages_[ key ];
+			if ( message.count_++ > 0 )
+			{
+				++message.pending_;
+				return;
+			}
+			message.severity_ = severity;
+			message.id_ = data.messageIdNumber;
+			message.name_ = data.pMessageIdName != nullptr ? data.pMessageIdName : "";
+			if ( message.name_.empty () )
+			{
+				message.name_ = std::string ( text ).substr ( 0 , 40 );
+			}
+
+			output.severity_ = severity;
+			output.id_ = message.id_;
+			output.id_name_ = data.pMessageIdName != nullptr ? data.pMessageIdName : "";
+		}
+		output.text_ = text;
+		Enqueue ( std::move ( output ) );
+	}
+
+	void ValidationSink::EndFrame ( uint64_t frame )
+	{
+		if ( frame < last_summary_ + summary_interval_ )
+		{
+			return;
+		}
+
+		std::vector<std::pair<uint64_t , std::string>> repeats;
+		uint64_t total { 0 };
+		{
+			std::lock_guard<std::mutex> lock ( messages_mutex_ );
+			for ( auto& message : messages_ )
+			{
+				if ( message.second.pending_ > 0 )
+				{
+					repeats.emplace_back ( message.second.pending_ , message.second.name_ );
+					total += message.second.pending_;
+					message.second.pending_ = 0;
+				}
+			}
+		}
+
+		uint64_t const first = last_summary_ + 1;
+		last_summary_ = frame;
+		if ( repeats.empty () )
+		{
+			return;
+		}
+
+		std::sort ( repeats.begin () , repeats.end () , [] ( auto const& a , auto const& b ) { return a.first > b.first; } );
+
+		size_t const listed = std::min<size_t> ( repeats.size () , 4 );
+		Output output;
+		output.text_ = std::to_string ( total ) + " repeated messages in frames " + std::to_string ( first ) + "-" + std::to_string ( frame ) + ":";
+		for ( size_t i = 0; i < listed; ++i )
+		{
+			output.text_ += " " + repeats[ i ].second + " x" + std::to_string ( repeats[ i ].first );
+		}
+		if ( repeats.size () > listed )
+		{
+			output.text_ += " and " + std::to_string ( repeats.size () - listed ) + " more";
+		}
+		Enqueue ( std::move ( output ) );
+	}
+
+	void ValidationSink::Report ()
+	{
+		{
+			std::unique_lock<std::mutex> lock ( queue_mutex_ );
+			drained_cv_.wait ( lock , [ this ] () { return queue_.empty () && !writing_; } );
+		}
+
+		std::vector<Message> messages;
+		{
+			std::lock_guard<std::mutex> lock ( messages_mutex_ );
+			for ( auto const& message : messages_ )
+			{
+				messages.push_back ( message.second );
+			}
+		}
+		if ( messages.empty () )
+		{
+			return;
+		}
+
+		std::sort ( messages.begin () , messages.end () , [] ( Message const& a , Message const& b ) { return a.count_ > b.count_; } );
+
+		std::printf ( "VALIDATION MESSAGES\n" );
+		std::printf ( "  %-8s %10s %12s  %s\n" , "severity" , "count" , "id" , "name" );
+		for ( auto const& message : messages )
+		{
+			std::printf ( "  %-8s %10llu %12d  %s\n" , SeverityName ( message.severity_ ) , static_cast< unsigned long long >( message.count_ ) ,
+						  message.id_ , message.name_.c_str () );
+		}
+	}
+
+	void ValidationSink::Enqueue ( Output output )
+	{
+		{
+			std::lock_guard<std::mutex> lock ( queue_mutex_ );
+			queue_.push_back ( std::move ( output ) );
+		}
+		queue_cv_.notify_one ();
+	}
+
+	void ValidationSink::Write ()
+	{
+		std::unique_lock<std::mutex> lock ( queue_mutex_ );
+		for ( ;; )
+		{
+			queue_cv_.wait ( lock , [ this ] () { return stop_ || !queue_.empty (); } );
+			if ( queue_.empty () )
+			{
+				return;
+			}
+
+			std::deque<Output> batch;
+			batch.swap ( queue_ );
+			writing_ = true;
+			lock.unlock ();
+
+			// one write and flush per batch, however many lines it holds
+			std::string text;
+			for ( auto const& output : batch )
+			{
+				text += "validation layer: ";
+				if ( output.severity_ != 0 )
+				{
+					text += std::string ( "[" ) + SeverityName ( output.severity_ ) + "] ";
+				}
+				if ( !output.id_name_.empty () )
+				{
+					text += output.id_name_ + " ";
+				}
+				text += output.text_;
+				text += '\n';
+			}
+			std::cerr << text << std::flush;
+
+			lock.lock ();
+			writing_ = false;
+			drained_cv_.notify_all ();
+		}
+	}
+
+	ValidationSink& GetValidationSink ()
+	{
+		static ValidationSink sink;
+		return sink;
+	}
+
+	bool ParseValidationSeverity ( std::string const& name , VkDebugUtilsMessageSeverityFlagsEXT& severities )
+	{
+		VkDebugUtilsMessageSeverityFlagsEXT const error = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+		VkDebugUtilsMessageSeverityFlagsEXT const warning = error | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+		VkDebugUtilsMessageSeverityFlagsEXT const info = warning | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+
+		if ( name == "error" )
+		{
+			severities = error;
+		}
+		else if ( name == "warning" )
+		{
+			severities = warning;
+		}
+		else if ( name == "info" )
+		{
+			severities = info;
+		}
+		else if ( name == "verbose" )
+		{
+			severities = info | VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,117 @@
+/* FILTERED, DEDUPLICATED AND ASYNCHRONOUS VALIDATION LAYER OUTPUT */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::ValidationSink___
+	 * **************************************************************
+	 * Receives debug messenger callbacks. Messages outside the
+	 * severity and type filters return at once. The first message
+	 * of each messageIdNumber is queued whole, later ones only bump
+	 * its counts, so the callback never formats or writes anything.
+	 * A background thread formats the queue to stderr.
+	 *
+	 * EndFrame() turns the repeats since the last summary into one
+	 * line, at most once every summary interval, instead of a line
+	 * per message.
+	 * **************************************************************
+	*/
+	class ValidationSink
+	{
+	public:
+		ValidationSink ();
+		~ValidationSink ();
+
+		ValidationSink ( ValidationSink const& ) = delete;
+		ValidationSink& operator= ( ValidationSink const& ) = delete;
+
+		// messengers subscribe to the severities set when they are created,
+		// narrowing applies at once, widening to messengers created afterwards
+		void SetSeverities ( VkDebugUtilsMessageSeverityFlagsEXT severities );
+		void SetTypes ( VkDebugUtilsMessageTypeFlagsEXT types );
+		VkDebugUtilsMessageSeverityFlagsEXT Severities () const;
+		VkDebugUtilsMessageTypeFlagsEXT Types () const;
+
+		// frames between repeat summaries, 1 for every frame
+		void SetSummaryInterval ( uint32_t frames );
+
+		// called from the debug callback, on any thread
+		void Submit ( VkDebugUtilsMessageSeverityFlagBitsEXT severity , VkDebugUtilsMessageTypeFlagsEXT type ,
+					  VkDebugUtilsMessengerCallbackDataEXT const& data );
+
+		void EndFrame ( uint64_t frame );
+
+		// waits for queued output, then prints every message id with its count
+		void Report ();
+
+	private:
+		struct Message
+		{
+			VkDebugUtilsMessageSeverityFlagBitsEXT severity_ {};
+			int32_t id_ { 0 };
+			// pMessageIdName, or the start of the text for messages without one
+			std::string name_;
+			uint64_t count_ { 0 };
+			// repeats since the last summary
+			uint64_t pending_ { 0 };
+		};
+
+		// formatted by the writer thread, summaries carry no id
+		struct Output
+		{
+			VkDebugUtilsMessageSeverityFlagBitsEXT severity_ {};
+			int32_t id_ { 0 };
+			std::string id_name_;
+			std::string text_;
+		};
+
+		void Write ();
+		void Enqueue ( Output output );
+
+		std::atomic<VkDebugUtilsMessageSeverityFlagsEXT> severities_;
+		std::atomic<VkDebugUtilsMessageTypeFlagsEXT> types_;
+		uint32_t summary_interval_ { 60 };
+		uint64_t last_summary_ { 0 };
+
+		// keyed on messageIdNumber, or a hash of the text for messages without one
+		std::mutex messages_mutex_;
+		std::unordered_map<uint64_t , Message> messages_;
+
+		// lines waiting for the writer thread
+		std::mutex queue_mutex_;
+		std::condition_variable queue_cv_;
+		std::condition_variable drained_cv_;
+		std::deque<Output> queue_;
+		bool writing_ { false };
+		bool stop_ { false };
+		std::thread writer_;
+	};
+
+	// the sink PopulateDebugMessengerCreateInfo hands to every messenger
+	ValidationSink& GetValidationSink ();
+
+	/*!
+	 * @brief ___JZvk::ParseValidationSeverity()___
+	 * **************************************************************
+	 * Lowest severity to report, one of verbose, info, warning or
+	 * error, to the mask of it and every severity above.
+	 * **************************************************************
+	 * @return bool
+	 * : False when name is none of the above.
+	 * **************************************************************
+	*/
+	bool ParseValidationSeverity ( std::string const& name , VkDebugUtilsMessageSeverityFlagsEXT& severities );
+}
@@ -0,0 +1,189 @@
+#include "JZvk_BindlessTable.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+
+namespace JZvk
+{
+	uint32_t BindlessTable::Slots::Acquire ()
+	{
+		if ( !free_.empty () )
+		{
+			uint32_t const index = free_.back ();
+			free_.pop_back ();
+			return index;
+		}
+		if ( next_ < capacity_ )
+		{
+			return next_++;
+		}
+		return INVALID_INDEX;
+	}
+
+	void BindlessTable::Slots::Release ( uint32_t index )
+	{
+		if ( index < next_ )
+		{
+			free_.push_back ( index );
+		}
+	}
+
+	bool BindlessTable::Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , DescriptorLayoutCache& layoutCache ,
+									 uint32_t maxTextures , uint32_t maxBuffers )
+	{
+		if ( !capabilities.descriptor_indexing_ )
+		{
+			Log ( LOG::INFO , "Bindless table disabled, descriptor indexing not supported." );
+			return false;
+		}
+
+		logical_device_ = logicalDevice;
+		textures_.capacity_ = std::min ( maxTextures , capabilities.max_bindless_sampled_images_ );
+		buffers_.capacity_ = std::min ( maxBuffers , capabilities.max_bindless_storage_buffers_ );
+
+		std::vector<VkDescriptorSetLayoutBinding> bindings = {
+			{ TEXTURE_BINDING , VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , textures_.capacity_ , VK_SHADER_STAGE_ALL_GRAPHICS , nullptr },
+			{ BUFFER_BINDING , VK_DESCRIPTOR_TYPE_STORAGE_BUFFER , buffers_.capacity_ , VK_SHADER_STAGE_ALL_GRAPHICS , nullptr }
+		};
+
+		// unwritten slots are never read, and slots can change while the set is bound
+		VkDescriptorBindingFlags const binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+			| VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+			| VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+		layout_ = layoutCache.Get ( bindings , VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT , { binding_flags , binding_flags } );
+		if ( layout_ == VK_NULL_HANDLE )
+		{
+			return false;
+		}
+
+		VkDescriptorPoolSize pool_sizes[] = {
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , textures_.capacity_ },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER , buffers_.capacity_ }
+		};
+
+		VkDescriptorPoolCreateInfo pool_info {};
+		pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		pool_info.maxSets = 1;
+		pool_info.poolSizeCount = 2;
+		pool_info.pPoolSizes = pool_sizes;
+
+		if ( vkCreateDescriptorPool ( logical_device_ , &pool_info , nullptr , &pool_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create bindless descriptor pool." );
+			return false;
+		}
+
+		VkDescriptorSetAllocateInfo alloc_info {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool = pool_;
+		alloc_info.descriptorSetCount = 1;
+		alloc_info.pSetLayouts = &layout_;
+
+		if ( vkAllocateDescriptorSets ( logical_device_ , &alloc_info , &set_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to allocate bindless descriptor set." );
+			return false;
+		}
+
+		Log ( LOG::INFO , "Bindless table: " , textures_.capacity_ , " textures, " , buffers_.capacity_ , " buffers." );
+		return true;
+	}
+
+	bool BindlessTable::Enabled () const
+	{
+		return set_ != VK_NULL_HANDLE;
+	}
+
+	VkDescriptorSetLayout BindlessTable::Layout () const
+	{
+		return layout_;
+	}
+
+	uint32_t BindlessTable::AddTexture ( VkImageView imageView , VkSampler sampler , VkImageLayout imageLayout )
+	{
+		uint32_t const index = textures_.Acquire ();
+		if ( index == INVALID_INDEX )
+		{
+			Log ( LOG::ERROR , "Bindless texture table is full." );
+			return INVALID_INDEX;
+		}
+
+		VkDescriptorImageInfo image_info {};
+		image_info.sampler = sampler;
+		image_info.imageView = imageView;
+		image_info.imageLayout = imageLayout;
+
+		VkWriteDescriptorSet write {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = set_;
+		write.dstBinding = TEXTURE_BINDING;
+		write.dstArrayElement = index;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo = &image_info;
+		vkUpdateDescriptorSets ( logical_device_ , 1 , &write , 0 , nullptr );
+
+		return index;
+	}
+
+	uint32_t BindlessTable::AddBuffer ( VkBuffer buffer , VkDeviceSize offset , VkDeviceSize range )
+	{
+		uint32_t const index = buffers_.Acquire ();
+		if ( index == INVALID_INDEX )
+		{
+			Log ( LOG::ERROR , "Bindless buffer table is full." );
+			return INVALID_INDEX;
+		}
+
+		VkDescriptorBufferInfo buffer_info {};
+		buffer_info.buffer = buffer;
+		buffer_info.offset = offset;
+		buffer_info.range = range;
+
+		VkWriteDescriptorSet write {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = set_;
+		write.dstBinding = BUFFER_BINDING;
+		write.dstArrayElement = index;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pBufferInfo = &buffer_info;
+		vkUpdateDescriptorSets ( logical_device_ , 1 , &write , 0 , nullptr );
+
+		return index;
+	}
+
+	void BindlessTable::RemoveTexture ( uint32_t index )
+	{
+		textures_.Release ( index );
+	}
+
+	void BindlessTable::RemoveBuffer ( uint32_t index )
+	{
+		buffers_.Release ( index );
+	}
+
+	void BindlessTable::Bind ( VkCommandBuffer commandBuffer , VkPipelineLayout pipelineLayout , uint32_t setIndex ) const
+	{
+		Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipelineLayout , setIndex , 1 , &set_ , 0 , nullptr );
+	}
+
+	void BindlessTable::Destroy ()
+	{
+		if ( pool_ != VK_NULL_HANDLE )
+		{
+			vkDestroyDescriptorPool ( logical_device_ , pool_ , nullptr );
+		}
+		pool_ = VK_NULL_HANDLE;
+		set_ = VK_NULL_HANDLE;
+		layout_ = VK_NULL_HANDLE;
+		textures_ = {};
+		buffers_ = {};
+	}
+}
@@ -0,0 +1,81 @@
+/* BINDLESS RESOURCE TABLE OVER DESCRIPTOR INDEXING */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../tools/JZvk_Support.h"
+#include "JZvk_DescriptorLayoutCache.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::BindlessTable___
+	 * **************************************************************
+	 * One descriptor set holding every texture and storage buffer
+	 * of the scene in two large arrays, bound once per command
+	 * buffer. Materials pass array indices in push constants
+	 * instead of binding a set per draw. shaders/bindless.glsl
+	 * declares the arrays, bindless.frag includes it and fetches
+	 * the triangle material's tint through MaterialConstants.
+	 *
+	 * The arrays are partially bound and update-after-bind, so
+	 * slots can be written while the set is in use by frames in
+	 * flight, as long as those frames do not read the slot.
+	 * **************************************************************
+	*/
+	class BindlessTable
+	{
+	public:
+		// set bindings, must match shaders/bindless.glsl, which bindless.frag includes
+		static constexpr uint32_t TEXTURE_BINDING = 0;
+		static constexpr uint32_t BUFFER_BINDING = 1;
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+		// returns false and stays disabled when the device lacks descriptor indexing
+		bool Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , DescriptorLayoutCache& layoutCache ,
+						  uint32_t maxTextures = 4096 , uint32_t maxBuffers = 1024 );
+
+		bool Enabled () const;
+
+		// layout is owned by the layout cache
+		VkDescriptorSetLayout Layout () const;
+
+		// index into the texture array, INVALID_INDEX if the table is full
+		uint32_t AddTexture ( VkImageView imageView , VkSampler sampler , VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+
+		// index into the buffer array, INVALID_INDEX if the table is full
+		uint32_t AddBuffer ( VkBuffer buffer , VkDeviceSize offset = 0 , VkDeviceSize range = VK_WHOLE_SIZE );
+
+		// slots are reused by later Add calls, frames still reading them must have retired
+		void RemoveTexture ( uint32_t index );
+		void RemoveBuffer ( uint32_t index );
+
+		void Bind ( VkCommandBuffer commandBuffer , VkPipelineLayout pipelineLayout , uint32_t setIndex = 0 ) const;
+
+		void Destroy ();
+
+	private:
+		struct Slots
+		{
+			uint32_t capacity_ { 0 };
+			uint32_t next_ { 0 };
+			std::vector<uint32_t> free_;
+
+			uint32_t Acquire ();
+			void Release ( uint32_t index );
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkDescriptorSetLayout layout_ { VK_NULL_HANDLE };
+		VkDescriptorPool pool_ { VK_NULL_HANDLE };
+		VkDescriptorSet set_ { VK_NULL_HANDLE };
+
+		Slots textures_;
+		Slots buffers_;
+	};
+}
@@ -0,0 +1,153 @@
+#include "JZvk_DescriptorAllocator.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+
+namespace JZvk
+{
+	std::vector<PoolSizeRatio> DescriptorAllocator::DefaultRatios ()
+	{
+		return {
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER , 2.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC , 1.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER , 1.0f },
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , 4.0f },
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE , 1.0f },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER , 0.5f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE , 0.5f }
+		};
+	}
+
+	void DescriptorAllocator::Initialize ( VkDevice logicalDevice , uint32_t setsPerPool , std::vector<PoolSizeRatio> ratios , VkDescriptorPoolCreateFlags flags )
+	{
+		logical_device_ = logicalDevice;
+		sets_per_pool_ = std::max ( setsPerPool , 1u );
+		ratios_ = std::move ( ratios );
+		flags_ = flags;
+	}
+
+	VkDescriptorSet DescriptorAllocator::Allocate ( VkDescriptorSetLayout layout , void const* pNext )
+	{
+		if ( current_pool_ == VK_NULL_HANDLE )
+		{
+			current_pool_ = GrabPool ();
+			if ( current_pool_ == VK_NULL_HANDLE )
+			{
+				return VK_NULL_HANDLE;
+			}
+		}
+
+		VkDescriptorSetAllocateInfo alloc_info {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.pNext = pNext;
+		alloc_info.descriptorPool = current_pool_;
+		alloc_info.descriptorSetCount = 1;
+		alloc_info.pSetLayouts = &layout;
+
+		VkDescriptorSet set { VK_NULL_HANDLE };
+		VkResult result = Dispatch ().AllocateDescriptorSets ( logical_device_ , &alloc_info , &set );
+
+		// current pool is full, chain a new one and retry once
+		if ( result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL )
+		{
+			current_pool_ = GrabPool ();
+			if ( current_pool_ == VK_NULL_HANDLE )
+			{
+				return VK_NULL_HANDLE;
+			}
+			alloc_info.descriptorPool = current_pool_;
+			result = Dispatch ().AllocateDescriptorSets ( logical_device_ , &alloc_info , &set );
+		}
+
+		if ( result != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to allocate descriptor set." );
+			return VK_NULL_HANDLE;
+		}
+		return set;
+	}
+
+	void DescriptorAllocator::Reset ()
+	{
+		for ( auto pool : used_pools_ )
+		{
+			Dispatch ().ResetDescriptorPool ( logical_device_ , pool , 0 );
+			free_pools_.push_back ( pool );
+		}
+		used_pools_.clear ();
+		current_pool_ = VK_NULL_HANDLE;
+	}
+
+	void DescriptorAllocator::Destroy ()
+	{
+		for ( auto pool : used_pools_ )
+		{
+			vkDestroyDescriptorPool ( logical_device_ , pool , nullptr );
+		}
+		for ( auto pool : free_pools_ )
+		{
+			vkDestroyDescriptorPool ( logical_device_ , pool , nullptr );
+		}
+		used_pools_.clear ();
+		free_pools_.clear ();
+		current_pool_ = VK_NULL_HANDLE;
+	}
+
+	size_t DescriptorAllocator::PoolCount () const
+	{
+		return used_pools_.size () + free_pools_.size ();
+	}
+
+	VkDescriptorPool DescriptorAllocator::GrabPool ()
+	{
+		VkDescriptorPool pool { VK_NULL_HANDLE };
+		if ( !free_pools_.empty () )
+		{
+			pool = free_pools_.back ();
+			free_pools_.pop_back ();
+		}
+		else
+		{
+			pool = CreatePool ( sets_per_pool_ );
+			// nothing to reset or destroy later, the next Allocate tries again
+			if ( pool == VK_NULL_HANDLE )
+			{
+				return VK_NULL_HANDLE;
+			}
+			// next pool is larger, so a busy allocator settles on few pools
+			sets_per_pool_ = std::min ( sets_per_pool_ + sets_per_pool_ / 2 , MAX_SETS_PER_POOL );
+		}
+		used_pools_.push_back ( pool );
+		return pool;
+	}
+
+	VkDescriptorPool DescriptorAllocator::CreatePool ( uint32_t setCount )
+	{
+		std::vector<VkDescriptorPoolSize> sizes;
+		sizes.reserve ( ratios_.size () );
+		for ( auto const& ratio : ratios_ )
+		{
+			uint32_t const count = static_cast< uint32_t >( ratio.ratio_ * static_cast< float >( setCount ) );
+			sizes.push_back ( { ratio.type_ , std::max ( count , 1u ) } );
+		}
+
+		VkDescriptorPoolCreateInfo pool_info {};
+		pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags = flags_;
+		pool_info.maxSets = setCount;
+		pool_info.poolSizeCount = static_cast< uint32_t >( sizes.size () );
+		pool_info.pPoolSizes = sizes.data ();
+
+		VkDescriptorPool pool { VK_NULL_HANDLE };
+		if ( vkCreateDescriptorPool ( logical_device_ , &pool_info , nullptr , &pool ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create descriptor pool." );
+			return VK_NULL_HANDLE;
+		}
+		return pool;
+	}
+}
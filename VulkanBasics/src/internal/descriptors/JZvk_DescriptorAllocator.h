@@ -0,0 +1,67 @@
+/* GROWABLE DESCRIPTOR SET ALLOCATION */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	// descriptors of a type reserved per set in every pool
+	struct PoolSizeRatio
+	{
+		VkDescriptorType type_;
+		float ratio_;
+	};
+
+	/*!
+	 * @brief ___JZvk::DescriptorAllocator___
+	 * **************************************************************
+	 * Allocates descriptor sets from a chain of pools. When the
+	 * current pool is out of memory or fragmented, a new pool is
+	 * chained and the allocation is retried, so callers never size
+	 * pools themselves. Pools grow geometrically up to a cap.
+	 *
+	 * Sets are not freed one at a time. Reset() returns every set
+	 * at once and keeps the pools for reuse, which is how the per
+	 * frame allocators are recycled once their frame has retired.
+	 * **************************************************************
+	*/
+	class DescriptorAllocator
+	{
+	public:
+		static std::vector<PoolSizeRatio> DefaultRatios ();
+
+		void Initialize ( VkDevice logicalDevice , uint32_t setsPerPool = 64 ,
+						  std::vector<PoolSizeRatio> ratios = DefaultRatios () , VkDescriptorPoolCreateFlags flags = 0 );
+
+		// VK_NULL_HANDLE if a fresh pool cannot be created or hold the set either
+		VkDescriptorSet Allocate ( VkDescriptorSetLayout layout , void const* pNext = nullptr );
+
+		// all sets from this allocator become invalid
+		void Reset ();
+
+		void Destroy ();
+
+		size_t PoolCount () const;
+
+	private:
+		// VK_NULL_HANDLE when a new pool cannot be created, it is not kept
+		VkDescriptorPool GrabPool ();
+		VkDescriptorPool CreatePool ( uint32_t setCount );
+
+		static constexpr uint32_t MAX_SETS_PER_POOL = 4096;
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		std::vector<PoolSizeRatio> ratios_;
+		VkDescriptorPoolCreateFlags flags_ { 0 };
+		uint32_t sets_per_pool_ { 0 };
+
+		VkDescriptorPool current_pool_ { VK_NULL_HANDLE };
+		// pools handed out since the last reset, and pools ready for reuse
+		std::vector<VkDescriptorPool> used_pools_;
+		std::vector<VkDescriptorPool> free_pools_;
+	};
+}
@@ -0,0 +1,154 @@
+#include "JZvk_DescriptorLayoutCache.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cstdint>
+
+namespace JZvk
+{
+	// boost style hash combine, order dependent
+	static void HashCombine ( size_t& seed , size_t value )
+	{
+		seed ^= value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+	}
+
+	bool DescriptorLayoutCache::LayoutKey::operator== ( LayoutKey const& rhs ) const
+	{
+		if ( flags_ != rhs.flags_ || bindings_.size () != rhs.bindings_.size () ||
+			binding_flags_ != rhs.binding_flags_ || samplers_ != rhs.samplers_ )
+		{
+			return false;
+		}
+
+		for ( size_t i = 0; i < bindings_.size (); ++i )
+		{
+			VkDescriptorSetLayoutBinding const& a = bindings_[ i ];
+			VkDescriptorSetLayoutBinding const& b = rhs.bindings_[ i ];
+			if ( a.binding != b.binding || a.descriptorType != b.descriptorType ||
+				a.descriptorCount != b.descriptorCount || a.stageFlags != b.stageFlags ||
+				( a.pImmutableSamplers == nullptr ) != ( b.pImmutableSamplers == nullptr ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t DescriptorLayoutCache::LayoutKeyHash::operator() ( LayoutKey const& key ) const
+	{
+		size_t seed = key.bindings_.size ();
+		HashCombine ( seed , key.flags_ );
+		for ( auto const& binding : key.bindings_ )
+		{
+			// binding and type packed into one word, count and stages into another
+			uint64_t const slot = static_cast< uint64_t >( binding.binding ) << 32 | static_cast< uint32_t >( binding.descriptorType );
+			uint64_t const usage = static_cast< uint64_t >( binding.descriptorCount ) << 32 | binding.stageFlags;
+			HashCombine ( seed , std::hash<uint64_t> {}( slot ) );
+			HashCombine ( seed , std::hash<uint64_t> {}( usage ) );
+		}
+		for ( auto const& binding_flags : key.binding_flags_ )
+		{
+			HashCombine ( seed , binding_flags );
+		}
+		for ( auto const& sampler : key.samplers_ )
+		{
+			HashCombine ( seed , std::hash<VkSampler> {}( sampler ) );
+		}
+		return seed;
+	}
+
+	void DescriptorLayoutCache::Initialize ( VkDevice logicalDevice )
+	{
+		logical_device_ = logicalDevice;
+	}
+
+	VkDescriptorSetLayout DescriptorLayoutCache::Get ( std::vector<VkDescriptorSetLayoutBinding> bindings , VkDescriptorSetLayoutCreateFlags flags ,
+													   std::vector<VkDescriptorBindingFlags> bindingFlags )
+	{
+		if ( !bindingFlags.empty () && bindingFlags.size () != bindings.size () )
+		{
+			Log ( LOG::ERROR , "Descriptor binding flags do not match the bindings." );
+			return VK_NULL_HANDLE;
+		}
+
+		// sort by binding number, binding flags follow their binding
+		std::vector<size_t> order ( bindings.size () );
+		for ( size_t i = 0; i < order.size (); ++i )
+		{
+			order[ i ] = i;
+		}
+		std::sort ( order.begin () , order.end () ,
+					[ & ] ( size_t a , size_t b )
+					{
+						return bindings[ a ].binding < bindings[ b ].binding;
+					} );
+
+		LayoutKey key;
+		key.flags_ = flags;
+		for ( size_t index : order )
+		{
+			VkDescriptorSetLayoutBinding const& binding = bindings[ index ];
+			key.bindings_.push_back ( binding );
+			if ( !bindingFlags.empty () )
+			{
+				key.binding_flags_.push_back ( bindingFlags[ index ] );
+			}
+			if ( binding.pImmutableSamplers )
+			{
+				key.samplers_.insert ( key.samplers_.end () , binding.pImmutableSamplers , binding.pImmutableSamplers + binding.descriptorCount );
+			}
+		}
+
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		auto it = layouts_.find ( key );
+		if ( it != layouts_.end () )
+		{
+			return it->second;
+		}
+
+		VkDescriptorSetLayoutCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		create_info.flags = flags;
+		create_info.bindingCount = static_cast< uint32_t >( key.bindings_.size () );
+		create_info.pBindings = key.bindings_.data ();
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info {};
+		binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		binding_flags_info.bindingCount = static_cast< uint32_t >( key.binding_flags_.size () );
+		binding_flags_info.pBindingFlags = key.binding_flags_.data ();
+		if ( !key.binding_flags_.empty () )
+		{
+			create_info.pNext = &binding_flags_info;
+		}
+
+		VkDescriptorSetLayout layout { VK_NULL_HANDLE };
+		if ( vkCreateDescriptorSetLayout ( logical_device_ , &create_info , nullptr , &layout ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create descriptor set layout." );
+			return VK_NULL_HANDLE;
+		}
+
+		// key keeps a copy of the bindings, the samplers they point to are owned by the caller
+		layouts_.emplace ( std::move ( key ) , layout );
+		return layout;
+	}
+
+	size_t DescriptorLayoutCache::Size ()
+	{
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		return layouts_.size ();
+	}
+
+	void DescriptorLayoutCache::Destroy ()
+	{
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		for ( auto& layout : layouts_ )
+		{
+			vkDestroyDescriptorSetLayout ( logical_device_ , layout.second , nullptr );
+		}
+		layouts_.clear ();
+	}
+}
@@ -0,0 +1,60 @@
+/* DEDUPLICATED DESCRIPTOR SET LAYOUTS */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::DescriptorLayoutCache___
+	 * **************************************************************
+	 * Creates each distinct descriptor set layout once. Layouts
+	 * are keyed on their create flags and bindings, so materials
+	 * declaring the same bindings share one VkDescriptorSetLayout
+	 * and stay compatible for descriptor set binds.
+	 * **************************************************************
+	*/
+	class DescriptorLayoutCache
+	{
+	public:
+		void Initialize ( VkDevice logicalDevice );
+
+		// binding order does not matter, bindings are sorted before lookup.
+		// bindingFlags is empty or holds one VkDescriptorBindingFlags per binding, in the same order
+		VkDescriptorSetLayout Get ( std::vector<VkDescriptorSetLayoutBinding> bindings , VkDescriptorSetLayoutCreateFlags flags = 0 ,
+									std::vector<VkDescriptorBindingFlags> bindingFlags = {} );
+
+		size_t Size ();
+
+		void Destroy ();
+
+	private:
+		struct LayoutKey
+		{
+			VkDescriptorSetLayoutCreateFlags flags_ { 0 };
+			std::vector<VkDescriptorSetLayoutBinding> bindings_;
+			// empty when no binding has flags
+			std::vector<VkDescriptorBindingFlags> binding_flags_;
+			// immutable samplers of all bindings, in binding order
+			std::vector<VkSampler> samplers_;
+
+			bool operator== ( LayoutKey const& rhs ) const;
+		};
+
+		struct LayoutKeyHash
+		{
+			size_t operator() ( LayoutKey const& key ) const;
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+
+		std::mutex mutex_;
+		std::unordered_map<LayoutKey , VkDescriptorSetLayout , LayoutKeyHash> layouts_;
+	};
+}
@@ -0,0 +1,133 @@
+#include "JZvk_TransientBindings.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+namespace JZvk
+{
+	void TransientBindings::Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , DescriptorLayoutCache& layoutCache ,
+										 std::vector<VkDescriptorSetLayoutBinding> const& bindings , bool allowPush )
+	{
+		logical_device_ = logicalDevice;
+
+		// maxPushDescriptors counts descriptors, an array binding takes descriptorCount of them
+		uint32_t descriptor_count { 0 };
+		for ( auto const& binding : bindings )
+		{
+			descriptor_count += binding.descriptorCount;
+		}
+
+		if ( allowPush && capabilities.push_descriptor_ && descriptor_count <= capabilities.max_push_descriptors_ )
+		{
+			push_descriptor_set_ = ( PFN_vkCmdPushDescriptorSetKHR ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdPushDescriptorSetKHR" );
+			push_descriptor_set_with_template_ = ( PFN_vkCmdPushDescriptorSetWithTemplateKHR ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdPushDescriptorSetWithTemplateKHR" );
+			if ( !push_descriptor_set_ || !push_descriptor_set_with_template_ )
+			{
+				Log ( LOG::ERROR , "Failed to load push descriptor commands, using descriptor sets." );
+				push_descriptor_set_ = nullptr;
+				push_descriptor_set_with_template_ = nullptr;
+			}
+		}
+
+		// push descriptor layouts cannot be allocated from pools, so the flag decides the path
+		layout_ = layoutCache.Get ( bindings , Pushed () ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0 );
+	}
+
+	VkDescriptorSetLayout TransientBindings::Layout () const
+	{
+		return layout_;
+	}
+
+	bool TransientBindings::Finalize ( VkPipelineLayout pipelineLayout , uint32_t setIndex , std::vector<VkDescriptorUpdateTemplateEntry> const& entries )
+	{
+		pipeline_layout_ = pipelineLayout;
+		set_index_ = setIndex;
+
+		VkDescriptorUpdateTemplateCreateInfo template_info {};
+		template_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		template_info.descriptorUpdateEntryCount = static_cast< uint32_t >( entries.size () );
+		template_info.pDescriptorUpdateEntries = entries.data ();
+		if ( Pushed () )
+		{
+			template_info.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+			template_info.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			template_info.pipelineLayout = pipelineLayout;
+			template_info.set = setIndex;
+		}
+		else
+		{
+			template_info.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+			template_info.descriptorSetLayout = layout_;
+		}
+
+		if ( vkCreateDescriptorUpdateTemplate ( logical_device_ , &template_info , nullptr , &update_template_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create descriptor update template." );
+			update_template_ = VK_NULL_HANDLE;
+			return false;
+		}
+		return true;
+	}
+
+	bool TransientBindings::Bind ( VkCommandBuffer commandBuffer , DescriptorAllocator& frameAllocator , void const* data ) const
+	{
+		if ( update_template_ == VK_NULL_HANDLE )
+		{
+			return false;
+		}
+
+		if ( Pushed () )
+		{
+			push_descriptor_set_with_template_ ( commandBuffer , update_template_ , pipeline_layout_ , set_index_ , data );
+			return true;
+		}
+
+		VkDescriptorSet set = frameAllocator.Allocate ( layout_ );
+		if ( set == VK_NULL_HANDLE )
+		{
+			return false;
+		}
+		Dispatch ().UpdateDescriptorSetWithTemplate ( logical_device_ , set , update_template_ , data );
+		Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline_layout_ , set_index_ , 1 , &set , 0 , nullptr );
+		return true;
+	}
+
+	bool TransientBindings::BindWrites ( VkCommandBuffer commandBuffer , DescriptorAllocator& frameAllocator , std::vector<VkWriteDescriptorSet>& writes ) const
+	{
+		if ( Pushed () )
+		{
+			push_descriptor_set_ ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline_layout_ , set_index_ ,
+								   static_cast< uint32_t >( writes.size () ) , writes.data () );
+			return true;
+		}
+
+		VkDescriptorSet set = frameAllocator.Allocate ( layout_ );
+		if ( set == VK_NULL_HANDLE )
+		{
+			return false;
+		}
+		for ( auto& write : writes )
+		{
+			write.dstSet = set;
+		}
+		Dispatch ().UpdateDescriptorSets ( logical_device_ , static_cast< uint32_t >( writes.size () ) , writes.data () , 0 , nullptr );
+		Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline_layout_ , set_index_ , 1 , &set , 0 , nullptr );
+		return true;
+	}
+
+	bool TransientBindings::Pushed () const
+	{
+		return push_descriptor_set_with_template_ != nullptr;
+	}
+
+	void TransientBindings::Destroy ()
+	{
+		if ( update_template_ != VK_NULL_HANDLE )
+		{
+			vkDestroyDescriptorUpdateTemplate ( logical_device_ , update_template_ , nullptr );
+		}
+		update_template_ = VK_NULL_HANDLE;
+		layout_ = VK_NULL_HANDLE;
+	}
+}
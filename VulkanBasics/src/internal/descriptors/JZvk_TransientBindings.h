@@ -0,0 +1,65 @@
+/* PER DRAW DESCRIPTOR BINDINGS, PUSHED OR ALLOCATED PER FRAME */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../tools/JZvk_Support.h"
+#include "JZvk_DescriptorLayoutCache.h"
+#include "JZvk_DescriptorAllocator.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::TransientBindings___
+	 * **************************************************************
+	 * Bindings of one descriptor set that change every draw. With
+	 * VK_KHR_push_descriptor they are written straight into the
+	 * command buffer, otherwise a set is taken from the frame's
+	 * DescriptorAllocator and updated. Both paths go through one
+	 * descriptor update template, so callers hand over a struct of
+	 * descriptor infos laid out as described by the entries.
+	 *
+	 * Initialize() creates the set layout, Finalize() the template
+	 * once the pipeline layout using that set layout exists.
+	 * **************************************************************
+	*/
+	class TransientBindings
+	{
+	public:
+		void Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , DescriptorLayoutCache& layoutCache ,
+						  std::vector<VkDescriptorSetLayoutBinding> const& bindings , bool allowPush = true );
+
+		VkDescriptorSetLayout Layout () const;
+
+		// entries give the offset of each binding's descriptor info inside the data passed to Bind(),
+		// false if the template could not be created
+		bool Finalize ( VkPipelineLayout pipelineLayout , uint32_t setIndex , std::vector<VkDescriptorUpdateTemplateEntry> const& entries );
+
+		// frameAllocator is only used without push descriptors. false if nothing was bound, without a
+		// template or when frameAllocator is out of sets, the draw has to be skipped
+		bool Bind ( VkCommandBuffer commandBuffer , DescriptorAllocator& frameAllocator , void const* data ) const;
+
+		// same as Bind() without the template, the writes' dstSet is filled in here
+		bool BindWrites ( VkCommandBuffer commandBuffer , DescriptorAllocator& frameAllocator , std::vector<VkWriteDescriptorSet>& writes ) const;
+
+		bool Pushed () const;
+
+		void Destroy ();
+
+	private:
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkDescriptorSetLayout layout_ { VK_NULL_HANDLE };
+		VkPipelineLayout pipeline_layout_ { VK_NULL_HANDLE };
+		uint32_t set_index_ { 0 };
+		VkDescriptorUpdateTemplate update_template_ { VK_NULL_HANDLE };
+
+		// loaded from the device, null without push descriptors
+		PFN_vkCmdPushDescriptorSetKHR push_descriptor_set_ { nullptr };
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR push_descriptor_set_with_template_ { nullptr };
+	};
+}
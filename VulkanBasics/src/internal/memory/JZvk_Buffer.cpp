@@ -0,0 +1,74 @@
+#include "JZvk_Buffer.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+namespace JZvk
+{
+	uint32_t FindMemoryType ( VkPhysicalDevice physicalDevice , uint32_t typeBits , VkMemoryPropertyFlags properties )
+	{
+		VkPhysicalDeviceMemoryProperties memory_properties;
+		vkGetPhysicalDeviceMemoryProperties ( physicalDevice , &memory_properties );
+
+		for ( uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i )
+		{
+			if ( ( typeBits & ( 1u << i ) ) && ( memory_properties.memoryTypes[ i ].propertyFlags & properties ) == properties )
+			{
+				return i;
+			}
+		}
+		return UINT32_MAX;
+	}
+
+	namespace Create
+	{
+		Buffer VKBuffer ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkDeviceSize size ,
+						  VkBufferUsageFlags usage , VkMemoryPropertyFlags properties )
+		{
+			Buffer buffer;
+			buffer.size_ = size;
+
+			VkBufferCreateInfo buffer_info {};
+			buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			buffer_info.size = size;
+			buffer_info.usage = usage;
+			buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			if ( vkCreateBuffer ( logicalDevice , &buffer_info , nullptr , &buffer.buffer_ ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to create buffer." );
+				return buffer;
+			}
+
+			VkMemoryRequirements requirements;
+			vkGetBufferMemoryRequirements ( logicalDevice , buffer.buffer_ , &requirements );
+
+			VkMemoryAllocateInfo alloc_info {};
+			alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			alloc_info.allocationSize = requirements.size;
+			alloc_info.memoryTypeIndex = FindMemoryType ( physicalDevice , requirements.memoryTypeBits , properties );
+
+			if ( alloc_info.memoryTypeIndex == UINT32_MAX ||
+				vkAllocateMemory ( logicalDevice , &alloc_info , nullptr , &buffer.memory_ ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to allocate buffer memory." );
+				return buffer;
+			}
+			vkBindBufferMemory ( logicalDevice , buffer.buffer_ , buffer.memory_ , 0 );
+
+			if ( properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+			{
+				vkMapMemory ( logicalDevice , buffer.memory_ , 0 , VK_WHOLE_SIZE , 0 , &buffer.mapped_ );
+			}
+			return buffer;
+		}
+	}
+
+	void DestroyBuffer ( VkDevice logicalDevice , Buffer& buffer )
+	{
+		// freeing the memory also unmaps it
+		vkDestroyBuffer ( logicalDevice , buffer.buffer_ , nullptr );
+		vkFreeMemory ( logicalDevice , buffer.memory_ , nullptr );
+		buffer = {};
+	}
+}
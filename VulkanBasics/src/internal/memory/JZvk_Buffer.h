@@ -0,0 +1,50 @@
+/* BUFFERS WITH THEIR OWN DEVICE MEMORY */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <cstdint>
+
+namespace JZvk
+{
+	struct Buffer
+	{
+		VkBuffer buffer_ { VK_NULL_HANDLE };
+		VkDeviceMemory memory_ { VK_NULL_HANDLE };
+		VkDeviceSize size_ { 0 };
+		// persistent mapping of host visible buffers, null otherwise
+		void* mapped_ { nullptr };
+	};
+
+	/*!
+	 * @brief ___JZvk::FindMemoryType()___
+	 * **************************************************************
+	 * Finds a memory type allowed by typeBits that has all of the
+	 * requested property flags.
+	 * **************************************************************
+	 * @return uint32_t
+	 * : Memory type index, UINT32_MAX if none matches.
+	 * **************************************************************
+	*/
+	uint32_t FindMemoryType ( VkPhysicalDevice physicalDevice , uint32_t typeBits , VkMemoryPropertyFlags properties );
+
+	namespace Create
+	{
+		/*!
+		 * @brief ___JZvk::Create::VKBuffer()___
+		 * **************************************************************
+		 * Creates a buffer bound to a dedicated allocation. Host
+		 * visible buffers are mapped once here and stay mapped until
+		 * DestroyBuffer().
+		 * **************************************************************
+		 * @return Buffer
+		 * : Buffer, memory and mapping.
+		 * **************************************************************
+		*/
+		Buffer VKBuffer ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkDeviceSize size ,
+						  VkBufferUsageFlags usage , VkMemoryPropertyFlags properties );
+	}
+
+	void DestroyBuffer ( VkDevice logicalDevice , Buffer& buffer );
+}
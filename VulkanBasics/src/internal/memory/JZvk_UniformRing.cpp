@@ -0,0 +1,139 @@
+#include "JZvk_UniformRing.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <cstring>
+
+namespace JZvk
+{
+	bool UniformRing::Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , DescriptorLayoutCache& layoutCache , DescriptorAllocator& allocator ,
+								   uint32_t framesInFlight , uint32_t payloadSize , uint32_t maxObjectsPerFrame ,
+								   VkShaderStageFlags stages , uint32_t pushOffset , bool allowPush )
+	{
+		logical_device_ = logicalDevice;
+		payload_size_ = payloadSize;
+		stages_ = stages;
+		push_offset_ = pushOffset;
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties ( physicalDevice , &properties );
+
+		push_fits_ = pushOffset + payloadSize <= properties.limits.maxPushConstantsSize;
+		push_ = allowPush && push_fits_;
+
+		// alignment is a power of two
+		VkDeviceSize const alignment = properties.limits.minUniformBufferOffsetAlignment;
+		slice_size_ = ( static_cast< VkDeviceSize >( payloadSize ) + alignment - 1 ) & ~( alignment - 1 );
+
+		// pushed payloads never touch the buffers, one slice keeps the set valid
+		VkDeviceSize const frame_size = slice_size_ * ( push_ ? 1 : maxObjectsPerFrame );
+
+		layout_ = layoutCache.Get ( { { BINDING , VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC , 1 , stages , nullptr } } );
+
+		frames_.resize ( framesInFlight );
+		for ( auto& frame : frames_ )
+		{
+			frame.buffer_ = Create::VKBuffer ( logicalDevice , physicalDevice , frame_size , VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT ,
+											   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+			if ( !frame.buffer_.mapped_ )
+			{
+				Log ( LOG::ERROR , "Failed to create uniform ring buffer." );
+				return false;
+			}
+
+			frame.set_ = allocator.Allocate ( layout_ );
+			if ( frame.set_ == VK_NULL_HANDLE )
+			{
+				Log ( LOG::ERROR , "Failed to allocate uniform ring descriptor set." );
+				return false;
+			}
+
+			// range is one slice, the dynamic offset picks which
+			VkDescriptorBufferInfo buffer_info { frame.buffer_.buffer_ , 0 , payloadSize };
+
+			VkWriteDescriptorSet write {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = frame.set_;
+			write.dstBinding = BINDING;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			write.pBufferInfo = &buffer_info;
+			vkUpdateDescriptorSets ( logicalDevice , 1 , &write , 0 , nullptr );
+		}
+
+		Log ( LOG::INFO , "UNIFORM RING" );
+		Log ( LOG::INFO , "\t" , push_ ? "push constants, " : "dynamic offsets, " , payloadSize , " byte payload, " , slice_size_ , " byte slices" );
+		return true;
+	}
+
+	VkDescriptorSetLayout UniformRing::Layout () const
+	{
+		return layout_;
+	}
+
+	VkPushConstantRange UniformRing::PushRange () const
+	{
+		return { stages_ , push_offset_ , push_fits_ ? payload_size_ : 0 };
+	}
+
+	bool UniformRing::PushesConstants () const
+	{
+		return push_;
+	}
+
+	void UniformRing::BeginFrame ( uint32_t frame )
+	{
+		frame_index_ = frame;
+		frames_[ frame ].cursor_ = 0;
+		frames_[ frame ].bound_to_ = VK_NULL_HANDLE;
+	}
+
+	bool UniformRing::Bind ( VkCommandBuffer commandBuffer , VkPipelineLayout pipelineLayout , uint32_t setIndex , void const* data )
+	{
+		Frame& frame = frames_[ frame_index_ ];
+
+		if ( push_ )
+		{
+			if ( frame.bound_to_ != commandBuffer )
+			{
+				uint32_t const offset = 0;
+				Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipelineLayout , setIndex , 1 , &frame.set_ , 1 , &offset );
+				frame.bound_to_ = commandBuffer;
+			}
+			Dispatch ().CmdPushConstants ( commandBuffer , pipelineLayout , stages_ , push_offset_ , payload_size_ , data );
+			return true;
+		}
+
+		if ( frame.cursor_ + slice_size_ > frame.buffer_.size_ )
+		{
+			return false;
+		}
+
+		// coherent memory, visible to the gpu once the frame is submitted
+		uint32_t const offset = static_cast< uint32_t >( frame.cursor_ );
+		std::memcpy ( static_cast< char* >( frame.buffer_.mapped_ ) + offset , data , payload_size_ );
+		frame.cursor_ += slice_size_;
+
+		Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipelineLayout , setIndex , 1 , &frame.set_ , 1 , &offset );
+		return true;
+	}
+
+	VkDeviceSize UniformRing::Used () const
+	{
+		return frames_.empty () ? 0 : frames_[ frame_index_ ].cursor_;
+	}
+
+	void UniformRing::Destroy ()
+	{
+		// sets go back with their allocator
+		for ( auto& frame : frames_ )
+		{
+			DestroyBuffer ( logical_device_ , frame.buffer_ );
+		}
+		frames_.clear ();
+		layout_ = VK_NULL_HANDLE;
+	}
+}
@@ -0,0 +1,82 @@
+/* PER FRAME RING OF PER OBJECT UNIFORM DATA */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "JZvk_Buffer.h"
+#include "../descriptors/JZvk_DescriptorLayoutCache.h"
+#include "../descriptors/JZvk_DescriptorAllocator.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::UniformRing___
+	 * **************************************************************
+	 * Per object uniform data of one fixed size payload. Every frame
+	 * in flight owns a persistently mapped uniform buffer that objects
+	 * take slices from, aligned to minUniformBufferOffsetAlignment,
+	 * and a single UNIFORM_BUFFER_DYNAMIC descriptor covering one
+	 * slice. Draws select their slice with a dynamic offset, so no
+	 * object needs a buffer or descriptor set of its own.
+	 *
+	 * When the payload fits in maxPushConstantsSize at pushOffset it
+	 * is pushed instead, shaders read either the push constant block
+	 * or the dynamic uniform buffer depending on PushesConstants().
+	 * **************************************************************
+	*/
+	class UniformRing
+	{
+	public:
+		static constexpr uint32_t BINDING = 0;
+
+		bool Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , DescriptorLayoutCache& layoutCache , DescriptorAllocator& allocator ,
+						  uint32_t framesInFlight , uint32_t payloadSize , uint32_t maxObjectsPerFrame ,
+						  VkShaderStageFlags stages , uint32_t pushOffset , bool allowPush = true );
+
+		VkDescriptorSetLayout Layout () const;
+
+		// push constant range of the payload, zero size when it does not fit in maxPushConstantsSize
+		// and must be left out of the pipeline layout. shaders that declare the push block need the
+		// range even when allowPush turned pushing off
+		VkPushConstantRange PushRange () const;
+
+		bool PushesConstants () const;
+
+		// rewinds the slices of a frame, only once its fence has been waited on
+		void BeginFrame ( uint32_t frame );
+
+		// writes payloadSize bytes of data for the next draw, false when the frame is out of slices
+		bool Bind ( VkCommandBuffer commandBuffer , VkPipelineLayout pipelineLayout , uint32_t setIndex , void const* data );
+
+		// bytes taken from the current frame's buffer
+		VkDeviceSize Used () const;
+
+		void Destroy ();
+
+	private:
+		struct Frame
+		{
+			Buffer buffer_;
+			VkDescriptorSet set_ { VK_NULL_HANDLE };
+			VkDeviceSize cursor_ { 0 };
+			// the set stays bound for push constant draws, bound once per command buffer
+			VkCommandBuffer bound_to_ { VK_NULL_HANDLE };
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkDescriptorSetLayout layout_ { VK_NULL_HANDLE };
+		std::vector<Frame> frames_;
+		uint32_t frame_index_ { 0 };
+		uint32_t payload_size_ { 0 };
+		VkDeviceSize slice_size_ { 0 };
+		VkShaderStageFlags stages_ { 0 };
+		uint32_t push_offset_ { 0 };
+		bool push_ { false };
+		bool push_fits_ { false };
+	};
+}
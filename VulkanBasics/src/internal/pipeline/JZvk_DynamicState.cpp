@@ -0,0 +1,87 @@
+#include "JZvk_DynamicState.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+namespace JZvk
+{
+	// extension commands are not exported by the loader, null when unsupported
+	static PFN_vkCmdSetCullModeEXT CmdSetCullMode { nullptr };
+	static PFN_vkCmdSetFrontFaceEXT CmdSetFrontFace { nullptr };
+	static PFN_vkCmdSetPrimitiveTopologyEXT CmdSetPrimitiveTopology { nullptr };
+	static PFN_vkCmdSetDepthTestEnableEXT CmdSetDepthTestEnable { nullptr };
+	static PFN_vkCmdSetDepthWriteEnableEXT CmdSetDepthWriteEnable { nullptr };
+	static PFN_vkCmdSetDepthCompareOpEXT CmdSetDepthCompareOp { nullptr };
+
+	void DynamicState::SetExtent ( VkExtent2D extent )
+	{
+		viewport_.x = 0.0f;
+		viewport_.y = 0.0f;
+		viewport_.width = static_cast< float >( extent.width );
+		viewport_.height = static_cast< float >( extent.height );
+		viewport_.minDepth = 0.0f;
+		viewport_.maxDepth = 1.0f;
+
+		scissor_.offset = { 0, 0 };
+		scissor_.extent = extent;
+	}
+
+	std::vector<VkDynamicState> GetDynamicStates ( DeviceCapabilities const& capabilities )
+	{
+		std::vector<VkDynamicState> states = {
+			VK_DYNAMIC_STATE_VIEWPORT,
+			VK_DYNAMIC_STATE_SCISSOR
+		};
+
+		if ( capabilities.extended_dynamic_state_ )
+		{
+			states.push_back ( VK_DYNAMIC_STATE_CULL_MODE_EXT );
+			states.push_back ( VK_DYNAMIC_STATE_FRONT_FACE_EXT );
+			states.push_back ( VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT );
+			states.push_back ( VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT );
+			states.push_back ( VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT );
+			states.push_back ( VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT );
+		}
+
+		return states;
+	}
+
+	void LoadDynamicStateFunctions ( VkDevice logicalDevice , DeviceCapabilities const& capabilities )
+	{
+		if ( !capabilities.extended_dynamic_state_ )
+		{
+			return;
+		}
+
+		CmdSetCullMode = ( PFN_vkCmdSetCullModeEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetCullModeEXT" );
+		CmdSetFrontFace = ( PFN_vkCmdSetFrontFaceEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetFrontFaceEXT" );
+		CmdSetPrimitiveTopology = ( PFN_vkCmdSetPrimitiveTopologyEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetPrimitiveTopologyEXT" );
+		CmdSetDepthTestEnable = ( PFN_vkCmdSetDepthTestEnableEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetDepthTestEnableEXT" );
+		CmdSetDepthWriteEnable = ( PFN_vkCmdSetDepthWriteEnableEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetDepthWriteEnableEXT" );
+		CmdSetDepthCompareOp = ( PFN_vkCmdSetDepthCompareOpEXT ) vkGetDeviceProcAddr ( logicalDevice , "vkCmdSetDepthCompareOpEXT" );
+
+		if ( !CmdSetCullMode || !CmdSetFrontFace || !CmdSetPrimitiveTopology ||
+			!CmdSetDepthTestEnable || !CmdSetDepthWriteEnable || !CmdSetDepthCompareOp )
+		{
+			Log ( LOG::ERROR , "Failed to load extended dynamic state commands." );
+		}
+	}
+
+	void CmdSetDynamicState ( VkCommandBuffer commandBuffer , DynamicState const& state )
+	{
+		Dispatch ().CmdSetViewport ( commandBuffer , 0 , 1 , &state.viewport_ );
+		Dispatch ().CmdSetScissor ( commandBuffer , 0 , 1 , &state.scissor_ );
+
+		// without the extension these values are baked into the pipeline instead
+		if ( CmdSetCullMode )
+		{
+			CmdSetCullMode ( commandBuffer , state.cull_mode_ );
+			CmdSetFrontFace ( commandBuffer , state.front_face_ );
+			CmdSetPrimitiveTopology ( commandBuffer , state.topology_ );
+			CmdSetDepthTestEnable ( commandBuffer , state.depth_test_ );
+			CmdSetDepthWriteEnable ( commandBuffer , state.depth_write_ );
+			CmdSetDepthCompareOp ( commandBuffer , state.depth_compare_ );
+		}
+	}
+}
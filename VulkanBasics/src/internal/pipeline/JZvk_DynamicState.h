@@ -0,0 +1,69 @@
+/* PIPELINE STATE SET AT RECORD TIME INSTEAD OF BAKED INTO PIPELINES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../tools/JZvk_Support.h"
+
+/* STD INCLUDES */
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::DynamicState___
+	 * **************************************************************
+	 * Values of every state the pipelines leave dynamic. Viewport
+	 * and scissor are always dynamic. The rest are dynamic with
+	 * extended dynamic state and baked from the same values
+	 * otherwise, so one struct describes both cases.
+	 * **************************************************************
+	*/
+	struct DynamicState
+	{
+		VkViewport viewport_ {};
+		VkRect2D scissor_ {};
+		VkCullModeFlags cull_mode_ { VK_CULL_MODE_BACK_BIT };
+		VkFrontFace front_face_ { VK_FRONT_FACE_CLOCKWISE };
+		// dynamic topology must stay in the topology class the pipeline was built with
+		VkPrimitiveTopology topology_ { VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST };
+		VkBool32 depth_test_ { VK_FALSE };
+		VkBool32 depth_write_ { VK_FALSE };
+		VkCompareOp depth_compare_ { VK_COMPARE_OP_LESS };
+
+		// full target viewport and scissor for extent
+		void SetExtent ( VkExtent2D extent );
+	};
+
+	/*!
+	 * @brief ___JZvk::GetDynamicStates()___
+	 * **************************************************************
+	 * States every pipeline marks as dynamic on this device, for
+	 * VkPipelineDynamicStateCreateInfo.
+	 * **************************************************************
+	 * @return std::vector<VkDynamicState>
+	 * : Viewport and scissor, plus extended states if supported.
+	 * **************************************************************
+	*/
+	std::vector<VkDynamicState> GetDynamicStates ( DeviceCapabilities const& capabilities );
+
+	/*!
+	 * @brief ___JZvk::LoadDynamicStateFunctions()___
+	 * **************************************************************
+	 * Loads the extended dynamic state commands from the device.
+	 * Call once after the logical device is created, before any
+	 * CmdSetDynamicState().
+	 * **************************************************************
+	*/
+	void LoadDynamicStateFunctions ( VkDevice logicalDevice , DeviceCapabilities const& capabilities );
+
+	/*!
+	 * @brief ___JZvk::CmdSetDynamicState()___
+	 * **************************************************************
+	 * Records every dynamic state of GetDynamicStates(), after the
+	 * pipeline is bound and before the first draw.
+	 * **************************************************************
+	*/
+	void CmdSetDynamicState ( VkCommandBuffer commandBuffer , DynamicState const& state );
+}
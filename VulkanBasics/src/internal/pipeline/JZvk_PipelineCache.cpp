@@ -0,0 +1,89 @@
+#include "JZvk_PipelineCache.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace JZvk
+{
+	// header every driver writes at the start of its cache data
+	struct PipelineCacheHeader
+	{
+		uint32_t header_size_;
+		uint32_t header_version_;
+		uint32_t vendor_id_;
+		uint32_t device_id_;
+		uint8_t pipeline_cache_uuid_[ VK_UUID_SIZE ];
+	};
+
+	static bool IsCacheCompatible ( std::vector<char> const& data , VkPhysicalDevice physicalDevice )
+	{
+		if ( data.size () < sizeof ( PipelineCacheHeader ) )
+		{
+			return false;
+		}
+
+		PipelineCacheHeader header;
+		std::memcpy ( &header , data.data () , sizeof ( header ) );
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties ( physicalDevice , &properties );
+
+		return header.header_version_ == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendor_id_ == properties.vendorID
+			&& header.device_id_ == properties.deviceID
+			&& std::memcmp ( header.pipeline_cache_uuid_ , properties.pipelineCacheUUID , VK_UUID_SIZE ) == 0;
+	}
+
+	namespace Create
+	{
+		VkPipelineCache VKPipelineCache ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , char const* path )
+		{
+			std::vector<char> data;
+			std::ifstream file ( path , std::ios::ate | std::ios::binary );
+			if ( file.is_open () )
+			{
+				data.resize ( static_cast< size_t >( file.tellg () ) );
+				file.seekg ( 0 );
+				file.read ( data.data () , static_cast< std::streamsize >( data.size () ) );
+			}
+
+			if ( !data.empty () && !IsCacheCompatible ( data , physicalDevice ) )
+			{
+				Log ( LOG::INFO , "Pipeline cache " , path , " is from another device or driver, starting empty." );
+				data.clear ();
+			}
+
+			VkPipelineCacheCreateInfo create_info {};
+			create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+			create_info.initialDataSize = data.size ();
+			create_info.pInitialData = data.empty () ? nullptr : data.data ();
+
+			VkPipelineCache pipeline_cache;
+			if ( vkCreatePipelineCache ( logicalDevice , &create_info , nullptr , &pipeline_cache ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to create pipeline cache." );
+			}
+			return pipeline_cache;
+		}
+	}
+
+	void SavePipelineCache ( VkDevice logicalDevice , VkPipelineCache pipelineCache , char const* path )
+	{
+		size_t size { 0 };
+		vkGetPipelineCacheData ( logicalDevice , pipelineCache , &size , nullptr );
+		std::vector<char> data ( size );
+		if ( size == 0 || vkGetPipelineCacheData ( logicalDevice , pipelineCache , &size , data.data () ) != VK_SUCCESS )
+		{
+			return;
+		}
+
+		std::ofstream file ( path , std::ios::binary | std::ios::trunc );
+		file.write ( data.data () , static_cast< std::streamsize >( size ) );
+	}
+}
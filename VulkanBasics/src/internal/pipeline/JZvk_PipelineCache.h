@@ -0,0 +1,32 @@
+/* PERSISTENT VKPIPELINECACHE */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+namespace JZvk
+{
+	namespace Create
+	{
+		/*!
+		 * @brief ___JZvk::Create::VKPipelineCache()___
+		 * **************************************************************
+		 * Creates a pipeline cache seeded from a file written by
+		 * SavePipelineCache(). Data from another device or driver is
+		 * discarded and an empty cache is created instead.
+		 * **************************************************************
+		 * @return VkPipelineCache
+		 * : Pipeline cache, shared by every pipeline the app creates.
+		 * **************************************************************
+		*/
+		VkPipelineCache VKPipelineCache ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , char const* path );
+	}
+
+	/*!
+	 * @brief ___JZvk::SavePipelineCache()___
+	 * **************************************************************
+	 * Writes the pipeline cache contents to disk so the next run can
+	 * skip driver compilation of pipelines it has seen before.
+	 * **************************************************************
+	*/
+	void SavePipelineCache ( VkDevice logicalDevice , VkPipelineCache pipelineCache , char const* path );
+}
@@ -0,0 +1,181 @@
+#include "JZvk_PipelineLibrary.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <chrono>
+
+namespace JZvk
+{
+	bool PipelineLibrary::Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , VkPipelineCache pipelineCache , VkPipelineLayout pipelineLayout ,
+									   ShaderPermutations const* fragmentPermutations , BuildPartFunction buildPart )
+	{
+		logical_device_ = logicalDevice;
+		pipeline_cache_ = pipelineCache;
+		pipeline_layout_ = pipelineLayout;
+		permutations_ = fragmentPermutations;
+		build_ = std::move ( buildPart );
+
+		if ( !capabilities.graphics_pipeline_library_ )
+		{
+			return false;
+		}
+		if ( !capabilities.fast_linking_ )
+		{
+			Log ( LOG::INFO , "Graphics pipeline library without fast linking, first use of a permutation may stall." );
+		}
+
+		// none of these depend on the fragment permutation
+		vertex_input_ = build_ ( nullptr , pipeline_cache_ , VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT );
+		pre_rasterization_ = build_ ( nullptr , pipeline_cache_ , VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT );
+		fragment_output_ = build_ ( nullptr , pipeline_cache_ , VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT );
+
+		enabled_ = vertex_input_ != VK_NULL_HANDLE && pre_rasterization_ != VK_NULL_HANDLE && fragment_output_ != VK_NULL_HANDLE;
+		if ( !enabled_ )
+		{
+			Log ( LOG::ERROR , "Failed to create pipeline library parts, using monolithic pipelines." );
+			Destroy ();
+		}
+		return enabled_;
+	}
+
+	bool PipelineLibrary::Enabled () const
+	{
+		return enabled_;
+	}
+
+	VkPipeline PipelineLibrary::Get ( PermutationKey key , bool specialized )
+	{
+		uint64_t const id = specialized ? ( uint64_t { 1 } << 32 ) | key : 0;
+
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		auto linked = linked_.find ( id );
+		if ( linked != linked_.end () )
+		{
+			Linked& entry = linked->second;
+			if ( entry.optimized_.valid () && entry.optimized_.wait_for ( std::chrono::seconds ( 0 ) ) == std::future_status::ready )
+			{
+				VkPipeline optimized = entry.optimized_.get ();
+				if ( optimized != VK_NULL_HANDLE )
+				{
+					retired_.push_back ( entry.pipeline_ );
+					entry.pipeline_ = optimized;
+				}
+			}
+			return entry.pipeline_;
+		}
+
+		SpecializationData data = permutations_->Specialize ( key , specialized );
+
+		// fragment shader part of the permutation, compiled once
+		VkPipeline fragment_shader { VK_NULL_HANDLE };
+		auto compiled = fragment_shaders_.find ( id );
+		if ( compiled != fragment_shaders_.end () )
+		{
+			fragment_shader = compiled->second;
+		}
+		else
+		{
+			fragment_shader = build_ ( data.Info () , pipeline_cache_ , VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT );
+			if ( fragment_shader != VK_NULL_HANDLE )
+			{
+				fragment_shaders_.emplace ( id , fragment_shader );
+			}
+		}
+
+		Parts const parts = { vertex_input_ , pre_rasterization_ , fragment_shader , fragment_output_ };
+		VkPipeline const fast_link = fragment_shader != VK_NULL_HANDLE ? Link ( parts , 0 ) : VK_NULL_HANDLE;
+
+		if ( fast_link == VK_NULL_HANDLE )
+		{
+			// monolithic for this permutation instead, nothing is cached when that fails too so the next Get retries
+			VkPipeline const monolithic = build_ ( data.Info () , pipeline_cache_ , 0 );
+			if ( monolithic == VK_NULL_HANDLE )
+			{
+				Log ( LOG::ERROR , "Failed to build permutation " , key , " from libraries or monolithically." );
+				return VK_NULL_HANDLE;
+			}
+			Log ( LOG::ERROR , "Failed to link permutation " , key , ", using a monolithic pipeline." );
+			linked_[ id ].pipeline_ = monolithic;
+			return monolithic;
+		}
+
+		Linked& entry = linked_[ id ];
+		entry.pipeline_ = fast_link;
+		entry.optimized_ = std::async ( std::launch::async , [ this , parts ] ()
+										{
+											return Link ( parts , VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT );
+										} );
+		return entry.pipeline_;
+	}
+
+	VkPipeline PipelineLibrary::Link ( Parts const& parts , VkPipelineCreateFlags flags ) const
+	{
+		VkPipelineLibraryCreateInfoKHR library_info {};
+		library_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+		library_info.libraryCount = static_cast< uint32_t >( parts.size () );
+		library_info.pLibraries = parts.data ();
+
+		VkGraphicsPipelineCreateInfo pipeline_info {};
+		pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipeline_info.pNext = &library_info;
+		pipeline_info.flags = flags;
+		pipeline_info.layout = pipeline_layout_;
+
+		// the pipeline cache is internally synchronized, background links share it
+		VkPipeline pipeline { VK_NULL_HANDLE };
+		if ( vkCreateGraphicsPipelines ( logical_device_ , pipeline_cache_ , 1 , &pipeline_info , nullptr , &pipeline ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to link graphics pipeline from libraries." );
+			return VK_NULL_HANDLE;
+		}
+		return pipeline;
+	}
+
+	void PipelineLibrary::Wait ()
+	{
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		for ( auto& linked : linked_ )
+		{
+			if ( linked.second.optimized_.valid () )
+			{
+				linked.second.optimized_.wait ();
+			}
+		}
+	}
+
+	void PipelineLibrary::Destroy ()
+	{
+		Wait ();
+
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		for ( auto& linked : linked_ )
+		{
+			if ( linked.second.optimized_.valid () )
+			{
+				vkDestroyPipeline ( logical_device_ , linked.second.optimized_.get () , nullptr );
+			}
+			vkDestroyPipeline ( logical_device_ , linked.second.pipeline_ , nullptr );
+		}
+		for ( auto pipeline : retired_ )
+		{
+			vkDestroyPipeline ( logical_device_ , pipeline , nullptr );
+		}
+		for ( auto const& fragment_shader : fragment_shaders_ )
+		{
+			vkDestroyPipeline ( logical_device_ , fragment_shader.second , nullptr );
+		}
+		vkDestroyPipeline ( logical_device_ , vertex_input_ , nullptr );
+		vkDestroyPipeline ( logical_device_ , pre_rasterization_ , nullptr );
+		vkDestroyPipeline ( logical_device_ , fragment_output_ , nullptr );
+
+		linked_.clear ();
+		retired_.clear ();
+		fragment_shaders_.clear ();
+		vertex_input_ = VK_NULL_HANDLE;
+		pre_rasterization_ = VK_NULL_HANDLE;
+		fragment_output_ = VK_NULL_HANDLE;
+		enabled_ = false;
+	}
+}
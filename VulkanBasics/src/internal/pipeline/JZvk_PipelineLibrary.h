@@ -0,0 +1,89 @@
+/* GRAPHICS PIPELINES LINKED FROM SEPARATELY COMPILED STAGE LIBRARIES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../tools/JZvk_Support.h"
+#include "../shaders/JZvk_ShaderPermutation.h"
+
+/* STD INCLUDES */
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::PipelineLibrary___
+	 * **************************************************************
+	 * Permutation pipelines built with VK_EXT_graphics_pipeline_library.
+	 * The vertex input, pre-rasterization, fragment shader and
+	 * fragment output parts are compiled as libraries through the
+	 * pipeline cache, the fragment shader part once per permutation
+	 * and the others once. A permutation's first Get() links the
+	 * parts without link time optimization, which is cheap, and
+	 * starts an optimized link in the background that replaces it
+	 * once finished.
+	 *
+	 * The build callback creates one library part, or a monolithic
+	 * pipeline when given no parts, and returns VK_NULL_HANDLE when
+	 * that fails. Without the extension or the shared parts
+	 * Initialize() returns false and callers keep using
+	 * PermutationPipelines.
+	 * **************************************************************
+	*/
+	class PipelineLibrary
+	{
+	public:
+		using BuildPartFunction = std::function<VkPipeline ( VkSpecializationInfo const* , VkPipelineCache , VkGraphicsPipelineLibraryFlagsEXT )>;
+
+		bool Initialize ( VkDevice logicalDevice , DeviceCapabilities const& capabilities , VkPipelineCache pipelineCache , VkPipelineLayout pipelineLayout ,
+						  ShaderPermutations const* fragmentPermutations , BuildPartFunction buildPart );
+
+		bool Enabled () const;
+
+		// the fast link until the optimized one is ready, call again to pick it up. a permutation that
+		// fails to link is built monolithically, VK_NULL_HANDLE and not cached when that fails as well
+		VkPipeline Get ( PermutationKey key , bool specialized = true );
+
+		// blocks until every background link has finished
+		void Wait ();
+
+		void Destroy ();
+
+	private:
+		using Parts = std::array<VkPipeline , 4>;
+
+		VkPipeline Link ( Parts const& parts , VkPipelineCreateFlags flags ) const;
+
+		struct Linked
+		{
+			VkPipeline pipeline_ { VK_NULL_HANDLE };
+			std::future<VkPipeline> optimized_;
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkPipelineCache pipeline_cache_ { VK_NULL_HANDLE };
+		VkPipelineLayout pipeline_layout_ { VK_NULL_HANDLE };
+		ShaderPermutations const* permutations_ { nullptr };
+		BuildPartFunction build_;
+		bool enabled_ { false };
+
+		// shared by every permutation
+		VkPipeline vertex_input_ { VK_NULL_HANDLE };
+		VkPipeline pre_rasterization_ { VK_NULL_HANDLE };
+		VkPipeline fragment_output_ { VK_NULL_HANDLE };
+
+		std::mutex mutex_;
+		// both keyed on (specialized << 32 | key), as in PermutationPipelines
+		std::unordered_map<uint64_t , VkPipeline> fragment_shaders_;
+		std::unordered_map<uint64_t , Linked> linked_;
+		// fast links that were replaced, command buffers in flight may still use them
+		std::vector<VkPipeline> retired_;
+	};
+}
@@ -0,0 +1,222 @@
+#include "JZvk_CpuProfiler.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace JZvk
+{
+	namespace Profiler
+	{
+		// per thread, power of two, the oldest events are overwritten
+		static constexpr uint64_t RING_CAPACITY = 16384;
+		// retired gpu frames kept for the trace
+		static constexpr size_t GPU_FRAMES = 1024;
+
+		struct Event
+		{
+			char const* name_;
+			uint64_t begin_;
+			uint64_t end_;
+		};
+
+		struct ThreadRing
+		{
+			std::string name_;
+			uint32_t id_ { 0 };
+			std::unique_ptr<Event[]> events_ { new Event[ RING_CAPACITY ] };
+			// events written, published with release after each one
+			std::atomic<uint64_t> head_ { 0 };
+		};
+
+		struct GpuFrame
+		{
+			uint64_t submit_ticks_;
+			std::vector<GpuProfiler::ZoneTiming> zones_;
+		};
+
+		struct Registry
+		{
+			// ticks and steady_clock read together, paired with a second reading at WriteTrace
+			uint64_t epoch_ticks_ { Ticks () };
+			std::chrono::steady_clock::time_point epoch_time_ { std::chrono::steady_clock::now () };
+
+			std::mutex mutex_;
+			std::vector<std::unique_ptr<ThreadRing>> threads_;
+			std::set<std::string> names_;
+			std::deque<GpuFrame> gpu_frames_;
+		};
+
+		static Registry& GetRegistry ()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		static ThreadRing& GetThreadRing ()
+		{
+			thread_local ThreadRing* ring = nullptr;
+			if ( ring == nullptr )
+			{
+				Registry& registry = GetRegistry ();
+				std::lock_guard<std::mutex> lock ( registry.mutex_ );
+				registry.threads_.push_back ( std::make_unique<ThreadRing> () );
+				ring = registry.threads_.back ().get ();
+				ring->id_ = static_cast< uint32_t >( registry.threads_.size () );
+				ring->name_ = "thread " + std::to_string ( ring->id_ );
+			}
+			return *ring;
+		}
+
+		void Record ( char const* name , uint64_t beginTicks , uint64_t endTicks )
+		{
+			ThreadRing& ring = GetThreadRing ();
+			uint64_t const head = ring.head_.load ( std::memory_order_relaxed );
+			ring.events_[ head & ( RING_CAPACITY - 1 ) ] = { name , beginTicks , endTicks };
+			ring.head_.store ( head + 1 , std::memory_order_release );
+		}
+
+		char const* Intern ( std::string const& name )
+		{
+			Registry& registry = GetRegistry ();
+			std::lock_guard<std::mutex> lock ( registry.mutex_ );
+			return registry.names_.insert ( name ).first->c_str ();
+		}
+
+		void SetThreadName ( char const* name )
+		{
+			ThreadRing& ring = GetThreadRing ();
+			std::lock_guard<std::mutex> lock ( GetRegistry ().mutex_ );
+			ring.name_ = name;
+		}
+
+		void RecordGpuFrame ( std::vector<GpuProfiler::ZoneTiming> const& zones , uint64_t submitTicks )
+		{
+			if ( zones.empty () )
+			{
+				return;
+			}
+			Registry& registry = GetRegistry ();
+			std::lock_guard<std::mutex> lock ( registry.mutex_ );
+			registry.gpu_frames_.push_back ( { submitTicks , zones } );
+			if ( registry.gpu_frames_.size () > GPU_FRAMES )
+			{
+				registry.gpu_frames_.pop_front ();
+			}
+		}
+
+		static void WriteEscaped ( std::ofstream& stream , char const* text )
+		{
+			for ( ; *text != '\0'; ++text )
+			{
+				if ( *text == '"' || *text == '\\' )
+				{
+					stream << '\\';
+				}
+				stream << *text;
+			}
+		}
+
+		static void WriteEvent ( std::ofstream& stream , bool& first , char const* name , double beginUs , double durationUs , int process , uint32_t thread )
+		{
+			stream << ( first ? "\n" : ",\n" ) << "{\"name\":\"";
+			WriteEscaped ( stream , name );
+			stream << "\",\"ph\":\"X\",\"ts\":" << beginUs << ",\"dur\":" << durationUs << ",\"pid\":" << process << ",\"tid\":" << thread << "}";
+			first = false;
+		}
+
+		static void WriteName ( std::ofstream& stream , bool& first , char const* kind , std::string const& name , int process , uint32_t thread )
+		{
+			stream << ( first ? "\n" : ",\n" ) << "{\"name\":\"" << kind << "\",\"ph\":\"M\",\"pid\":" << process << ",\"tid\":" << thread << ",\"args\":{\"name\":\"";
+			WriteEscaped ( stream , name.c_str () );
+			stream << "\"}}";
+			first = false;
+		}
+
+		bool WriteTrace ( std::string const& path )
+		{
+			Registry& registry = GetRegistry ();
+
+			// microseconds per tick over the whole run
+			uint64_t const now_ticks = Ticks ();
+			double const elapsed_us = std::chrono::duration<double , std::micro> ( std::chrono::steady_clock::now () - registry.epoch_time_ ).count ();
+			double const us_per_tick = now_ticks > registry.epoch_ticks_ ? elapsed_us / static_cast< double >( now_ticks - registry.epoch_ticks_ ) : 0.0;
+			auto to_us = [ & ] ( uint64_t ticks )
+			{
+				return static_cast< double >( static_cast< int64_t >( ticks - registry.epoch_ticks_ ) ) * us_per_tick;
+			};
+
+			std::ofstream stream ( path , std::ios::trunc );
+			if ( !stream )
+			{
+				Log ( LOG::ERROR , "Failed to open trace file " , path , "." );
+				return false;
+			}
+			stream.setf ( std::ios::fixed );
+			stream.precision ( 3 );
+
+			const int cpu_process = 1;
+			const int gpu_process = 2;
+			size_t events { 0 };
+			bool first { true };
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			std::lock_guard<std::mutex> lock ( registry.mutex_ );
+			WriteName ( stream , first , "process_name" , "CPU" , cpu_process , 0 );
+			for ( auto const& thread : registry.threads_ )
+			{
+				WriteName ( stream , first , "thread_name" , thread->name_ , cpu_process , thread->id_ );
+
+				// a thread still recording may overwrite the oldest of these while they are read
+				uint64_t const head = thread->head_.load ( std::memory_order_acquire );
+				uint64_t const oldest = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+				for ( uint64_t i = oldest; i < head; ++i )
+				{
+					Event const& event = thread->events_[ i & ( RING_CAPACITY - 1 ) ];
+					double const begin_us = to_us ( event.begin_ );
+					WriteEvent ( stream , first , event.name_ , begin_us , to_us ( event.end_ ) - begin_us , cpu_process , thread->id_ );
+					++events;
+				}
+			}
+
+			// gpu clocks are not calibrated against the cpu, each frame keeps its own spacing
+			// and starts at its submit or where the previous frame ended, whichever is later
+			if ( !registry.gpu_frames_.empty () )
+			{
+				WriteName ( stream , first , "process_name" , "GPU" , gpu_process , 0 );
+				WriteName ( stream , first , "thread_name" , "graphics queue" , gpu_process , 1 );
+			}
+			double gpu_end_us { 0.0 };
+			for ( auto const& frame : registry.gpu_frames_ )
+			{
+				uint64_t frame_begin_ns = frame.zones_.front ().begin_ns_;
+				for ( auto const& zone : frame.zones_ )
+				{
+					frame_begin_ns = std::min ( frame_begin_ns , zone.begin_ns_ );
+				}
+				double const frame_start_us = std::max ( to_us ( frame.submit_ticks_ ) , gpu_end_us );
+				for ( auto const& zone : frame.zones_ )
+				{
+					double const begin_us = frame_start_us + static_cast< double >( zone.begin_ns_ - frame_begin_ns ) * 1e-3;
+					double const duration_us = static_cast< double >( zone.end_ns_ - zone.begin_ns_ ) * 1e-3;
+					WriteEvent ( stream , first , zone.name_ , begin_us , duration_us , gpu_process , 1 );
+					gpu_end_us = std::max ( gpu_end_us , begin_us + duration_us );
+					++events;
+				}
+			}
+
+			stream << "\n]}\n";
+			Log ( LOG::INFO , "TRACE" );
+			Log ( LOG::INFO , "\t" , events , " events written to " , path );
+			return static_cast< bool >( stream );
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/* CPU ZONES ON PER THREAD RINGS, EXPORTED AS A CHROME TRACE */
+#pragma once
+
+/* PROJECT INCLUDES */
+#include "JZvk_GpuProfiler.h"
+
+/* STD INCLUDES */
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#define JZVK_PROFILE_TSC
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define JZVK_PROFILE_TSC
+#endif
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::Profiler___
+	 * **************************************************************
+	 * Scoped CPU zones, recorded through the JZVK_PROFILE_ macros
+	 * below. Those expand to nothing unless JZVK_PROFILING is
+	 * defined, so instrumented code costs nothing in other builds.
+	 *
+	 * A zone reads the time stamp counter when it opens and closes,
+	 * and writes one event to a ring owned by the calling thread, no
+	 * locks after the thread's first zone. Rings keep the most recent
+	 * events and outlive their thread. WriteTrace() converts ticks to
+	 * microseconds against steady_clock and writes Chrome trace JSON,
+	 * which chrome://tracing and ui.perfetto.dev both open. GPU zones
+	 * handed to RecordGpuFrame() appear as their own process on the
+	 * same timeline.
+	 * **************************************************************
+	*/
+	namespace Profiler
+	{
+		constexpr bool Enabled ()
+		{
+#ifdef JZVK_PROFILING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		inline uint64_t Ticks ()
+		{
+#ifdef JZVK_PROFILE_TSC
+			return __rdtsc ();
+#else
+			return static_cast< uint64_t >( std::chrono::steady_clock::now ().time_since_epoch ().count () );
+#endif
+		}
+
+		// one finished zone on the calling thread's ring, name must outlive the trace
+		void Record ( char const* name , uint64_t beginTicks , uint64_t endTicks );
+
+		// stable copy of a name built at run time, for zones named after data
+		char const* Intern ( std::string const& name );
+
+		// names the calling thread's track in the trace
+		void SetThreadName ( char const* name );
+
+		// zones of a retired gpu frame, placed no earlier than submitTicks and after the previous frame
+		void RecordGpuFrame ( std::vector<GpuProfiler::ZoneTiming> const& zones , uint64_t submitTicks );
+
+		// every event recorded so far, false when path cannot be written
+		bool WriteTrace ( std::string const& path );
+
+		class Zone
+		{
+		public:
+			explicit Zone ( char const* name )
+				: name_ { name } ,
+				  begin_ { Ticks () }
+			{
+			}
+
+			~Zone ()
+			{
+				Record ( name_ , begin_ , Ticks () );
+			}
+
+			Zone ( Zone const& ) = delete;
+			Zone& operator= ( Zone const& ) = delete;
+
+		private:
+			char const* name_;
+			uint64_t begin_;
+		};
+	}
+}
+
+#ifdef JZVK_PROFILING
+#define JZVK_PROFILE_CONCAT_INNER( a , b ) a##b
+#define JZVK_PROFILE_CONCAT( a , b ) JZVK_PROFILE_CONCAT_INNER ( a , b )
+// zone from here to the end of the enclosing scope
+#define JZVK_PROFILE_ZONE( name ) ::JZvk::Profiler::Zone JZVK_PROFILE_CONCAT ( jzvk_profile_zone_ , __LINE__ ) ( name )
+#define JZVK_PROFILE_FUNCTION() JZVK_PROFILE_ZONE ( __FUNCTION__ )
+#define JZVK_PROFILE_THREAD( name ) ::JZvk::Profiler::SetThreadName ( name )
+#else
+// arguments are not evaluated either
+#define JZVK_PROFILE_ZONE( name )
+#define JZVK_PROFILE_FUNCTION()
+#define JZVK_PROFILE_THREAD( name )
+#endif
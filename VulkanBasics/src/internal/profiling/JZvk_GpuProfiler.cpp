@@ -0,0 +1,192 @@
+#include "JZvk_GpuProfiler.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <cstring>
+#include <utility>
+
+namespace JZvk
+{
+	bool GpuProfiler::Initialize ( VkDevice logicalDevice , DeviceContext const& context , uint32_t framesInFlight ,
+								   uint32_t maxZonesPerFrame , size_t window )
+	{
+		logical_device_ = logicalDevice;
+		max_zones_ = maxZonesPerFrame;
+		metrics_ = MetricSet ( window );
+
+		uint32_t const queue_family = context.queue_family_indices_.graphics_family_.value ();
+		uint32_t const valid_bits = context.queue_families_[ queue_family ].timestampValidBits;
+		if ( valid_bits == 0 || context.properties_.limits.timestampPeriod <= 0.0f )
+		{
+			Log ( LOG::INFO , "Graphics queue has no timestamps, gpu profiler disabled." );
+			return false;
+		}
+		timestamp_period_ns_ = context.properties_.limits.timestampPeriod;
+		timestamp_mask_ = valid_bits >= 64 ? ~uint64_t { 0 } : ( uint64_t { 1 } << valid_bits ) - 1;
+
+		frames_.resize ( framesInFlight );
+		for ( auto& frame : frames_ )
+		{
+			VkQueryPoolCreateInfo query_info {};
+			query_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			query_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			query_info.queryCount = 2 * maxZonesPerFrame;
+			if ( vkCreateQueryPool ( logicalDevice , &query_info , nullptr , &frame.pool_ ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to create gpu profiler query pool." );
+				Destroy ();
+				return false;
+			}
+			frame.zones_.reserve ( maxZonesPerFrame );
+		}
+		// value and availability of every query
+		results_.resize ( 4 * static_cast< size_t >( maxZonesPerFrame ) );
+
+		enabled_ = true;
+		Log ( LOG::INFO , "GPU PROFILER" );
+		Log ( LOG::INFO , "\t" , maxZonesPerFrame , " zones per frame, " , timestamp_period_ns_ , " ns per tick, " , valid_bits , " valid bits" );
+		return true;
+	}
+
+	bool GpuProfiler::Enabled () const
+	{
+		return enabled_;
+	}
+
+	void GpuProfiler::BeginFrame ( VkCommandBuffer commandBuffer , uint32_t frame )
+	{
+		if ( !enabled_ )
+		{
+			return;
+		}
+		recording_ = frame;
+		frames_[ frame ].zones_.clear ();
+		frames_[ frame ].depth_ = 0;
+		Dispatch ().CmdResetQueryPool ( commandBuffer , frames_[ frame ].pool_ , 0 , 2 * max_zones_ );
+	}
+
+	uint32_t GpuProfiler::BeginZone ( VkCommandBuffer commandBuffer , char const* name , VkPipelineStageFlagBits stage )
+	{
+		if ( !enabled_ )
+		{
+			return NO_ZONE;
+		}
+		Frame& frame = frames_[ recording_ ];
+		if ( frame.zones_.size () == max_zones_ )
+		{
+			return NO_ZONE;
+		}
+
+		uint32_t const zone = static_cast< uint32_t >( frame.zones_.size () );
+		frame.zones_.push_back ( { name , frame.depth_++ , false } );
+		Dispatch ().CmdWriteTimestamp ( commandBuffer , stage , frame.pool_ , 2 * zone );
+		return zone;
+	}
+
+	void GpuProfiler::EndZone ( VkCommandBuffer commandBuffer , uint32_t zone , VkPipelineStageFlagBits stage )
+	{
+		if ( zone == NO_ZONE )
+		{
+			return;
+		}
+		Frame& frame = frames_[ recording_ ];
+		frame.zones_[ zone ].ended_ = true;
+		--frame.depth_;
+		Dispatch ().CmdWriteTimestamp ( commandBuffer , stage , frame.pool_ , 2 * zone + 1 );
+	}
+
+	void GpuProfiler::Retire ( uint32_t frameIndex )
+	{
+		if ( !enabled_ )
+		{
+			return;
+		}
+		last_frame_.clear ();
+		Frame& frame = frames_[ frameIndex ];
+		if ( frame.zones_.empty () )
+		{
+			return;
+		}
+
+		// the fence has signaled so everything written is available, no wait bit in case a zone was never ended
+		uint32_t const query_count = 2 * static_cast< uint32_t >( frame.zones_.size () );
+		VkResult const result = Dispatch ().GetQueryPoolResults ( logical_device_ , frame.pool_ , 0 , query_count ,
+																  query_count * 2 * sizeof ( uint64_t ) , results_.data () , 2 * sizeof ( uint64_t ) ,
+																  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT );
+		if ( result != VK_SUCCESS && result != VK_NOT_READY )
+		{
+			frame.zones_.clear ();
+			return;
+		}
+
+		std::vector<std::pair<char const* , double>> totals;
+		for ( size_t i = 0; i < frame.zones_.size (); ++i )
+		{
+			Zone const& zone = frame.zones_[ i ];
+			uint64_t const* begin = &results_[ 4 * i ];
+			uint64_t const* end = &results_[ 4 * i + 2 ];
+			if ( !zone.ended_ || begin[ 1 ] == 0 || end[ 1 ] == 0 )
+			{
+				continue;
+			}
+
+			uint64_t const ticks = ( ( end[ 0 ] & timestamp_mask_ ) - ( begin[ 0 ] & timestamp_mask_ ) ) & timestamp_mask_;
+			uint64_t const begin_ns = static_cast< uint64_t >( static_cast< double >( begin[ 0 ] & timestamp_mask_ ) * timestamp_period_ns_ );
+			uint64_t const elapsed_ns = static_cast< uint64_t >( static_cast< double >( ticks ) * timestamp_period_ns_ );
+			last_frame_.push_back ( { zone.name_ , zone.depth_ , begin_ns , begin_ns + elapsed_ns } );
+
+			auto total = totals.begin ();
+			while ( total != totals.end () && std::strcmp ( total->first , zone.name_ ) != 0 )
+			{
+				++total;
+			}
+			if ( total == totals.end () )
+			{
+				totals.emplace_back ( zone.name_ , 0.0 );
+				total = totals.end () - 1;
+			}
+			total->second += static_cast< double >( elapsed_ns ) * 1e-6;
+		}
+		for ( auto const& total : totals )
+		{
+			metrics_.Record ( total.first , total.second );
+		}
+		frame.zones_.clear ();
+	}
+
+	MetricSet const& GpuProfiler::Metrics () const
+	{
+		return metrics_;
+	}
+
+	std::vector<GpuProfiler::ZoneTiming> const& GpuProfiler::LastFrame () const
+	{
+		return last_frame_;
+	}
+
+	void GpuProfiler::Destroy ()
+	{
+		for ( auto& frame : frames_ )
+		{
+			vkDestroyQueryPool ( logical_device_ , frame.pool_ , nullptr );
+		}
+		frames_.clear ();
+		last_frame_.clear ();
+		enabled_ = false;
+	}
+
+	GpuZone::GpuZone ( GpuProfiler& profiler , VkCommandBuffer commandBuffer , char const* name )
+		: profiler_ { profiler } ,
+		  command_buffer_ { commandBuffer } ,
+		  zone_ { profiler.BeginZone ( commandBuffer , name ) }
+	{
+	}
+
+	GpuZone::~GpuZone ()
+	{
+		profiler_.EndZone ( command_buffer_ , zone_ );
+	}
+}
@@ -0,0 +1,116 @@
+/* GPU TIME OF SCOPED ZONES FROM TIMESTAMP QUERIES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "JZvk_Metrics.h"
+#include "../tools/JZvk_DeviceContext.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::GpuProfiler___
+	 * **************************************************************
+	 * Timestamp queries around zones of the recorded command buffers.
+	 * Every frame in flight owns a query pool with two queries per
+	 * zone, reset at BeginFrame(). Retire() reads a frame back once
+	 * its fence has been waited on, without the wait bit, so reading
+	 * never stalls, and records each zone's time in milliseconds.
+	 *
+	 * Zones may nest, names must outlive the frame, string literals
+	 * in practice. Zones sharing a name in one frame are summed.
+	 * Without timestamps on the graphics queue every call is a no-op.
+	 * **************************************************************
+	*/
+	class GpuProfiler
+	{
+	public:
+		static constexpr uint32_t NO_ZONE = UINT32_MAX;
+
+		// one zone of the last retired frame, begin and end on the gpu clock
+		struct ZoneTiming
+		{
+			char const* name_;
+			uint32_t depth_;
+			uint64_t begin_ns_;
+			uint64_t end_ns_;
+		};
+
+		bool Initialize ( VkDevice logicalDevice , DeviceContext const& context , uint32_t framesInFlight ,
+						  uint32_t maxZonesPerFrame = 32 , size_t window = 120 );
+
+		bool Enabled () const;
+
+		// resets the frame's queries, record it before the first render pass
+		void BeginFrame ( VkCommandBuffer commandBuffer , uint32_t frame );
+
+		// NO_ZONE when disabled or out of queries, EndZone ignores it
+		uint32_t BeginZone ( VkCommandBuffer commandBuffer , char const* name , VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT );
+		void EndZone ( VkCommandBuffer commandBuffer , uint32_t zone , VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT );
+
+		// call once the fence of frame has been waited on
+		void Retire ( uint32_t frame );
+
+		// milliseconds per zone name
+		MetricSet const& Metrics () const;
+
+		// empty when the last Retire() had nothing to read
+		std::vector<ZoneTiming> const& LastFrame () const;
+
+		void Destroy ();
+
+	private:
+		struct Zone
+		{
+			char const* name_;
+			uint32_t depth_;
+			bool ended_;
+		};
+
+		struct Frame
+		{
+			VkQueryPool pool_ { VK_NULL_HANDLE };
+			std::vector<Zone> zones_;
+			uint32_t depth_ { 0 };
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		bool enabled_ { false };
+		double timestamp_period_ns_ { 1.0 };
+		uint64_t timestamp_mask_ { 0 };
+		uint32_t max_zones_ { 0 };
+
+		std::vector<Frame> frames_;
+		uint32_t recording_ { 0 };
+
+		MetricSet metrics_;
+		std::vector<ZoneTiming> last_frame_;
+		std::vector<uint64_t> results_;
+	};
+
+	/*!
+	 * @brief ___JZvk::GpuZone___
+	 * **************************************************************
+	 * Begins a zone on construction and ends it on destruction.
+	 * **************************************************************
+	*/
+	class GpuZone
+	{
+	public:
+		GpuZone ( GpuProfiler& profiler , VkCommandBuffer commandBuffer , char const* name );
+		~GpuZone ();
+
+		GpuZone ( GpuZone const& ) = delete;
+		GpuZone& operator= ( GpuZone const& ) = delete;
+
+	private:
+		GpuProfiler& profiler_;
+		VkCommandBuffer command_buffer_;
+		uint32_t zone_;
+	};
+}
@@ -0,0 +1,116 @@
+#include "JZvk_Metrics.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace JZvk
+{
+	RollingWindow::RollingWindow ( size_t capacity )
+		: values_ ( std::max<size_t> ( capacity , 1 ) )
+	{
+	}
+
+	void RollingWindow::Record ( double value )
+	{
+		values_[ next_ ] = value;
+		next_ = ( next_ + 1 ) % values_.size ();
+		count_ = std::min ( count_ + 1 , values_.size () );
+	}
+
+	size_t RollingWindow::Count () const
+	{
+		return count_;
+	}
+
+	double RollingWindow::Last () const
+	{
+		return count_ == 0 ? 0.0 : values_[ ( next_ + values_.size () - 1 ) % values_.size () ];
+	}
+
+	double RollingWindow::Mean () const
+	{
+		if ( count_ == 0 )
+		{
+			return 0.0;
+		}
+		double sum { 0.0 };
+		for ( size_t i = 0; i < count_; ++i )
+		{
+			sum += values_[ i ];
+		}
+		return sum / static_cast< double >( count_ );
+	}
+
+	double RollingWindow::Min () const
+	{
+		return count_ == 0 ? 0.0 : *std::min_element ( values_.begin () , values_.begin () + count_ );
+	}
+
+	double RollingWindow::Max () const
+	{
+		return count_ == 0 ? 0.0 : *std::max_element ( values_.begin () , values_.begin () + count_ );
+	}
+
+	double RollingWindow::Percentile ( double p ) const
+	{
+		if ( count_ == 0 )
+		{
+			return 0.0;
+		}
+		// the window is unordered once it has wrapped, sort a copy
+		std::vector<double> sorted ( values_.begin () , values_.begin () + count_ );
+		size_t const rank = static_cast< size_t >( std::ceil ( std::clamp ( p , 0.0 , 1.0 ) * static_cast< double >( count_ ) ) );
+		size_t const index = rank == 0 ? 0 : rank - 1;
+		std::nth_element ( sorted.begin () , sorted.begin () + index , sorted.end () );
+		return sorted[ index ];
+	}
+
+	MetricSet::MetricSet ( size_t window )
+		: window_ { window }
+	{
+	}
+
+	void MetricSet::Record ( std::string const& name , double value )
+	{
+		auto found = index_.find ( name );
+		if ( found == index_.end () )
+		{
+			found = index_.emplace ( name , windows_.size () ).first;
+			names_.push_back ( name );
+			windows_.emplace_back ( window_ );
+		}
+		windows_[ found->second ].Record ( value );
+	}
+
+	RollingWindow const* MetricSet::Find ( std::string const& name ) const
+	{
+		auto const found = index_.find ( name );
+		return found == index_.end () ? nullptr : &windows_[ found->second ];
+	}
+
+	std::vector<std::string> const& MetricSet::Names () const
+	{
+		return names_;
+	}
+
+	void MetricSet::Print ( std::string const& title ) const
+	{
+		std::printf ( "%s\n" , title.c_str () );
+		std::printf ( "  %-32s %12s %12s %12s %12s %12s\n" , "metric" , "last" , "mean" , "p50" , "p95" , "max" );
+		for ( size_t i = 0; i < names_.size (); ++i )
+		{
+			RollingWindow const& window = windows_[ i ];
+			std::printf ( "  %-32s %12.4g %12.4g %12.4g %12.4g %12.4g\n" , names_[ i ].c_str () ,
+						  window.Last () , window.Mean () , window.Percentile ( 0.50 ) , window.Percentile ( 0.95 ) , window.Max () );
+		}
+	}
+
+	void MetricSet::Clear ()
+	{
+		names_.clear ();
+		windows_.clear ();
+		index_.clear ();
+	}
+}
@@ -0,0 +1,74 @@
+/* ROLLING WINDOWS OF NAMED PER FRAME MEASUREMENTS */
+#pragma once
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::RollingWindow___
+	 * **************************************************************
+	 * The last capacity values of one measurement, older ones are
+	 * overwritten. Unlike Bench::Histogram it follows changes in the
+	 * scene instead of averaging over the whole run.
+	 * **************************************************************
+	*/
+	class RollingWindow
+	{
+	public:
+		explicit RollingWindow ( size_t capacity = 120 );
+
+		void Record ( double value );
+
+		size_t Count () const;
+		double Last () const;
+		double Mean () const;
+		double Min () const;
+		double Max () const;
+
+		// p in [0,1], nearest rank over the window
+		double Percentile ( double p ) const;
+
+	private:
+		std::vector<double> values_;
+		size_t next_ { 0 };
+		size_t count_ { 0 };
+	};
+
+	/*!
+	 * @brief ___JZvk::MetricSet___
+	 * **************************************************************
+	 * Rolling windows by name, kept in the order they were first
+	 * recorded. Profilers and counters publish through one of these
+	 * so every per frame measurement is read and printed the same
+	 * way.
+	 * **************************************************************
+	*/
+	class MetricSet
+	{
+	public:
+		explicit MetricSet ( size_t window = 120 );
+
+		void Record ( std::string const& name , double value );
+
+		// null until name has been recorded
+		RollingWindow const* Find ( std::string const& name ) const;
+
+		std::vector<std::string> const& Names () const;
+
+		// last, mean, p50, p95 and max of every metric as a table to stdout
+		void Print ( std::string const& title ) const;
+
+		void Clear ();
+
+	private:
+		size_t window_;
+		std::vector<std::string> names_;
+		std::vector<RollingWindow> windows_;
+		std::unordered_map<std::string , size_t> index_;
+	};
+}
@@ -0,0 +1,217 @@
+#include "JZvk_PipelineStatistics.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <string>
+
+namespace JZvk
+{
+	// counters queried, in bit order, which is the order results are written in
+	static constexpr struct
+	{
+		VkQueryPipelineStatisticFlags bit_;
+		char const* name_;
+	} COUNTERS[] = {
+		{ VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT , "input vertices" } ,
+		{ VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT , "vertex invocations" } ,
+		{ VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT , "clipping invocations" } ,
+		{ VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT , "clipping primitives" } ,
+		{ VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT , "fragment invocations" } ,
+		{ VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT , "compute invocations" }
+	};
+	static constexpr uint32_t COUNTER_COUNT = sizeof ( COUNTERS ) / sizeof ( COUNTERS[ 0 ] );
+
+	enum Counter : uint32_t
+	{
+		INPUT_VERTICES = 0 ,
+		VERTEX_INVOCATIONS = 1 ,
+		FRAGMENT_INVOCATIONS = 4
+	};
+
+	bool PipelineStatistics::Initialize ( VkDevice logicalDevice , DeviceContext const& context , uint32_t framesInFlight ,
+										  uint32_t maxPassesPerFrame , size_t window )
+	{
+		logical_device_ = logicalDevice;
+		max_passes_ = maxPassesPerFrame;
+		metrics_ = MetricSet ( window );
+		statistics_ = context.capabilities_.pipeline_statistics_query_;
+		precise_ = context.capabilities_.occlusion_query_precise_;
+
+		VkQueryPipelineStatisticFlags counters { 0 };
+		for ( auto const& counter : COUNTERS )
+		{
+			counters |= counter.bit_;
+		}
+
+		frames_.resize ( framesInFlight );
+		for ( auto& frame : frames_ )
+		{
+			VkQueryPoolCreateInfo query_info {};
+			query_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			query_info.queryCount = maxPassesPerFrame;
+
+			query_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+			bool created = vkCreateQueryPool ( logicalDevice , &query_info , nullptr , &frame.occlusion_ ) == VK_SUCCESS;
+			if ( statistics_ )
+			{
+				query_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+				query_info.pipelineStatistics = counters;
+				created = created && vkCreateQueryPool ( logicalDevice , &query_info , nullptr , &frame.statistics_ ) == VK_SUCCESS;
+			}
+			if ( !created )
+			{
+				Log ( LOG::ERROR , "Failed to create pipeline statistics query pools." );
+				Destroy ();
+				return false;
+			}
+			frame.passes_.reserve ( maxPassesPerFrame );
+		}
+		// counters and availability of the largest result, one pass at a time
+		results_.resize ( COUNTER_COUNT + 1 );
+
+		enabled_ = true;
+		Log ( LOG::INFO , "PIPELINE STATISTICS" );
+		Log ( LOG::INFO , "\t" , statistics_ ? "pipeline statistics and occlusion" : "occlusion only, no pipelineStatisticsQuery" , ", " , maxPassesPerFrame , " passes per frame" );
+		if ( !precise_ )
+		{
+			Log ( LOG::INFO , "\t" , "no occlusionQueryPrecise, samples passed and overdraw are not recorded" );
+		}
+		return true;
+	}
+
+	bool PipelineStatistics::Enabled () const
+	{
+		return enabled_;
+	}
+
+	bool PipelineStatistics::PreciseOcclusion () const
+	{
+		return precise_;
+	}
+
+	void PipelineStatistics::BeginFrame ( VkCommandBuffer commandBuffer , uint32_t frame )
+	{
+		if ( !enabled_ )
+		{
+			return;
+		}
+		recording_ = frame;
+		frames_[ frame ].passes_.clear ();
+		Dispatch ().CmdResetQueryPool ( commandBuffer , frames_[ frame ].occlusion_ , 0 , max_passes_ );
+		if ( statistics_ )
+		{
+			Dispatch ().CmdResetQueryPool ( commandBuffer , frames_[ frame ].statistics_ , 0 , max_passes_ );
+		}
+	}
+
+	uint32_t PipelineStatistics::Begin ( VkCommandBuffer commandBuffer , char const* name )
+	{
+		if ( !enabled_ )
+		{
+			return NO_PASS;
+		}
+		Frame& frame = frames_[ recording_ ];
+		if ( frame.passes_.size () == max_passes_ )
+		{
+			return NO_PASS;
+		}
+
+		uint32_t const pass = static_cast< uint32_t >( frame.passes_.size () );
+		frame.passes_.push_back ( { name , false } );
+		// without the precise bit the result only has to be nonzero when any sample passed
+		Dispatch ().CmdBeginQuery ( commandBuffer , frame.occlusion_ , pass , precise_ ? VK_QUERY_CONTROL_PRECISE_BIT : 0 );
+		if ( statistics_ )
+		{
+			Dispatch ().CmdBeginQuery ( commandBuffer , frame.statistics_ , pass , 0 );
+		}
+		return pass;
+	}
+
+	void PipelineStatistics::End ( VkCommandBuffer commandBuffer , uint32_t pass )
+	{
+		if ( pass == NO_PASS )
+		{
+			return;
+		}
+		Frame& frame = frames_[ recording_ ];
+		frame.passes_[ pass ].ended_ = true;
+		if ( statistics_ )
+		{
+			Dispatch ().CmdEndQuery ( commandBuffer , frame.statistics_ , pass );
+		}
+		Dispatch ().CmdEndQuery ( commandBuffer , frame.occlusion_ , pass );
+	}
+
+	void PipelineStatistics::Retire ( uint32_t frameIndex )
+	{
+		if ( !enabled_ )
+		{
+			return;
+		}
+		Frame& frame = frames_[ frameIndex ];
+
+		VkQueryResultFlags const flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+		for ( uint32_t pass = 0; pass < static_cast< uint32_t >( frame.passes_.size () ); ++pass )
+		{
+			if ( !frame.passes_[ pass ].ended_ )
+			{
+				continue;
+			}
+			std::string const prefix = std::string ( frame.passes_[ pass ].name_ ) + "/";
+
+			// the fence has signaled, no wait bit so a missing result is skipped rather than waited on
+			uint64_t samples[ 2 ] = {};
+			VkResult result = Dispatch ().GetQueryPoolResults ( logical_device_ , frame.occlusion_ , pass , 1 , sizeof ( samples ) , samples , sizeof ( samples ) , flags );
+			bool const has_samples = precise_ && result == VK_SUCCESS && samples[ 1 ] != 0;
+			if ( has_samples )
+			{
+				metrics_.Record ( prefix + "samples passed" , static_cast< double >( samples[ 0 ] ) );
+			}
+
+			if ( !statistics_ )
+			{
+				continue;
+			}
+			size_t const stride = ( COUNTER_COUNT + 1 ) * sizeof ( uint64_t );
+			result = Dispatch ().GetQueryPoolResults ( logical_device_ , frame.statistics_ , pass , 1 , stride , results_.data () , stride , flags );
+			if ( result != VK_SUCCESS || results_[ COUNTER_COUNT ] == 0 )
+			{
+				continue;
+			}
+			for ( uint32_t i = 0; i < COUNTER_COUNT; ++i )
+			{
+				metrics_.Record ( prefix + COUNTERS[ i ].name_ , static_cast< double >( results_[ i ] ) );
+			}
+
+			// derived, overdraw is only approximate with multisampling or discard
+			if ( has_samples && samples[ 0 ] > 0 )
+			{
+				metrics_.Record ( prefix + "overdraw" , static_cast< double >( results_[ FRAGMENT_INVOCATIONS ] ) / static_cast< double >( samples[ 0 ] ) );
+			}
+			if ( results_[ INPUT_VERTICES ] > 0 )
+			{
+				metrics_.Record ( prefix + "vertex shading ratio" , static_cast< double >( results_[ VERTEX_INVOCATIONS ] ) / static_cast< double >( results_[ INPUT_VERTICES ] ) );
+			}
+		}
+		frame.passes_.clear ();
+	}
+
+	MetricSet const& PipelineStatistics::Metrics () const
+	{
+		return metrics_;
+	}
+
+	void PipelineStatistics::Destroy ()
+	{
+		for ( auto& frame : frames_ )
+		{
+			vkDestroyQueryPool ( logical_device_ , frame.occlusion_ , nullptr );
+			vkDestroyQueryPool ( logical_device_ , frame.statistics_ , nullptr );
+		}
+		frames_.clear ();
+		enabled_ = false;
+	}
+}
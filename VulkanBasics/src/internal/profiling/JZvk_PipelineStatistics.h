@@ -0,0 +1,87 @@
+/* PER PASS PIPELINE STATISTICS AND OCCLUSION COUNTS */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "JZvk_Metrics.h"
+#include "../tools/JZvk_DeviceContext.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::PipelineStatistics___
+	 * **************************************************************
+	 * Counts per pass, read back like GpuProfiler's timestamps.
+	 * Every frame in flight owns a pipeline statistics pool, when the
+	 * device has pipelineStatisticsQuery, and an occlusion pool, with
+	 * one query per pass. Retire() reads a frame without waiting and
+	 * records each pass's counters as "<pass>/<counter>" in Metrics(),
+	 * the same MetricSet interface the timings use.
+	 *
+	 * Fragment invocations against samples passed is the overdraw of
+	 * a pass, vertex invocations against input vertices its vertex
+	 * reuse, both are recorded as well. Samples passed and overdraw
+	 * need occlusionQueryPrecise, without it an occlusion result is
+	 * only known to be nonzero and neither is recorded. Passes must
+	 * begin and end outside a render pass or within one subpass.
+	 * **************************************************************
+	*/
+	class PipelineStatistics
+	{
+	public:
+		static constexpr uint32_t NO_PASS = UINT32_MAX;
+
+		bool Initialize ( VkDevice logicalDevice , DeviceContext const& context , uint32_t framesInFlight ,
+						  uint32_t maxPassesPerFrame = 8 , size_t window = 120 );
+
+		bool Enabled () const;
+
+		// false when samples passed and overdraw are not recorded, see occlusionQueryPrecise
+		bool PreciseOcclusion () const;
+
+		// resets the frame's queries, outside any render pass
+		void BeginFrame ( VkCommandBuffer commandBuffer , uint32_t frame );
+
+		// NO_PASS when disabled or out of queries, End ignores it
+		uint32_t Begin ( VkCommandBuffer commandBuffer , char const* name );
+		void End ( VkCommandBuffer commandBuffer , uint32_t pass );
+
+		// call once the fence of frame has been waited on
+		void Retire ( uint32_t frame );
+
+		MetricSet const& Metrics () const;
+
+		void Destroy ();
+
+	private:
+		struct Pass
+		{
+			char const* name_;
+			bool ended_;
+		};
+
+		struct Frame
+		{
+			VkQueryPool statistics_ { VK_NULL_HANDLE };
+			VkQueryPool occlusion_ { VK_NULL_HANDLE };
+			std::vector<Pass> passes_;
+		};
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		bool enabled_ { false };
+		bool statistics_ { false };
+		bool precise_ { false };
+		uint32_t max_passes_ { 0 };
+
+		std::vector<Frame> frames_;
+		uint32_t recording_ { 0 };
+
+		MetricSet metrics_;
+		std::vector<uint64_t> results_;
+	};
+}
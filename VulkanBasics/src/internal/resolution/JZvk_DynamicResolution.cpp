@@ -0,0 +1,457 @@
+#include "JZvk_DynamicResolution.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../tools/JZvk_Create.h"
+#include "../tools/JZvk_DeviceDispatch.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace JZvk
+{
+	// matches the push constant block of upscale.frag
+	struct UpscaleConstants
+	{
+		float uv_scale_[ 2 ];
+		float uv_max_[ 2 ];
+	};
+
+	void ResolutionController::Configure ( double targetMs , float minScale , float maxScale )
+	{
+		target_ms_ = targetMs;
+		min_scale_ = minScale;
+		max_scale_ = maxScale;
+		scale_ = maxScale;
+		smoothed_ms_ = 0.0;
+	}
+
+	float ResolutionController::Update ( double gpuMs )
+	{
+		smoothed_ms_ = smoothed_ms_ <= 0.0 ? gpuMs : smoothed_ms_ + ( gpuMs - smoothed_ms_ ) * SMOOTHING;
+		if ( smoothed_ms_ <= 0.0 || ( smoothed_ms_ <= target_ms_ && smoothed_ms_ >= target_ms_ * HEADROOM ) )
+		{
+			return scale_;
+		}
+
+		float const wanted = scale_ * static_cast< float >( std::sqrt ( target_ms_ * AIM / smoothed_ms_ ) );
+		float const scale = std::clamp ( std::clamp ( wanted , scale_ * ( 1.0f - MAX_STEP ) , scale_ * ( 1.0f + MAX_STEP ) ) , min_scale_ , max_scale_ );
+
+		// the next frames are expected at the new pixel count, otherwise the lag of the
+		// smoothing and of the frames in flight keeps pushing the scale past the target
+		smoothed_ms_ *= static_cast< double >( scale * scale ) / static_cast< double >( scale_ * scale_ );
+		scale_ = scale;
+		return scale_;
+	}
+
+	float ResolutionController::Scale () const
+	{
+		return scale_;
+	}
+
+	double ResolutionController::SmoothedMs () const
+	{
+		return smoothed_ms_;
+	}
+
+	bool DynamicResolution::Initialize ( VkDevice logicalDevice , DeviceContext const& context , GpuProfiler const& profiler ,
+										 DescriptorLayoutCache& layoutCache , DescriptorAllocator& allocator , VkPipelineCache pipelineCache ,
+										 VkRenderPass outputPass , VkFormat format , VkExtent2D outputExtent , uint32_t framesInFlight ,
+										 SPIRVView vertexShader , SPIRVView fragmentShader , double targetMs , float minScale )
+	{
+		logical_device_ = logicalDevice;
+		physical_device_ = context.physical_device_;
+		capabilities_ = context.capabilities_;
+		format_ = format;
+		output_extent_ = outputExtent;
+		output_pass_ = outputPass;
+		frames_ = framesInFlight;
+
+		// the controller has nothing to go on without gpu times
+		if ( !profiler.Enabled () )
+		{
+			Log ( LOG::ERROR , "Gpu profiler has no timestamps, dynamic resolution disabled." );
+			return false;
+		}
+
+		VkSamplerCreateInfo sampler_info {};
+		sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		sampler_info.magFilter = VK_FILTER_LINEAR;
+		sampler_info.minFilter = VK_FILTER_LINEAR;
+		sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		sampler_info.maxLod = 0.0f;
+		if ( vkCreateSampler ( logicalDevice , &sampler_info , nullptr , &sampler_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create dynamic resolution sampler." );
+			Destroy ();
+			return false;
+		}
+
+		set_layout_ = layoutCache.Get ( { { 0 , VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER , 1 , VK_SHADER_STAGE_FRAGMENT_BIT , nullptr } } );
+		sets_.resize ( framesInFlight );
+		for ( auto& set : sets_ )
+		{
+			set = allocator.Allocate ( set_layout_ );
+		}
+
+		if ( !CreateScenePass ( format ) ||
+			!CreateUpscalePipeline ( pipelineCache , outputPass , vertexShader , fragmentShader ) ||
+			!CreateTargets ( outputExtent ) )
+		{
+			Destroy ();
+			return false;
+		}
+
+		controller_.Configure ( targetMs , minScale , 1.0f );
+		upscale_state_.cull_mode_ = VK_CULL_MODE_NONE;
+		enabled_ = true;
+
+		Log ( LOG::INFO , "DYNAMIC RESOLUTION" );
+		Log ( LOG::INFO , "\t" , "target " , targetMs , " ms gpu, scale " , minScale , " to 1" );
+		return true;
+	}
+
+	bool DynamicResolution::Enabled () const
+	{
+		return enabled_;
+	}
+
+	bool DynamicResolution::Fits ( VkExtent2D outputExtent ) const
+	{
+		VkExtent2D const allocated = targets_.Extent ();
+		return outputExtent.width <= allocated.width && outputExtent.height <= allocated.height;
+	}
+
+	bool DynamicResolution::Resize ( VkExtent2D outputExtent )
+	{
+		output_extent_ = outputExtent;
+		if ( Fits ( outputExtent ) )
+		{
+			return true;
+		}
+		DestroyTargets ();
+		return CreateTargets ( outputExtent );
+	}
+
+	VkExtent2D DynamicResolution::BeginScene ( VkCommandBuffer commandBuffer , uint32_t frame , VkClearValue clearValue )
+	{
+		// never larger than the targets, never empty
+		float const scale = controller_.Scale ();
+		VkExtent2D const allocated = targets_.Extent ();
+		render_extent_.width = std::clamp ( static_cast< uint32_t >( std::lround ( output_extent_.width * scale ) ) , 1u , allocated.width );
+		render_extent_.height = std::clamp ( static_cast< uint32_t >( std::lround ( output_extent_.height * scale ) ) , 1u , allocated.height );
+
+		VkRenderPassBeginInfo pass_info {};
+		pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		pass_info.renderPass = scene_pass_;
+		pass_info.framebuffer = framebuffers_[ frame ];
+		pass_info.renderArea.offset = { 0 , 0 };
+		pass_info.renderArea.extent = render_extent_;
+		pass_info.clearValueCount = 1;
+		pass_info.pClearValues = &clearValue;
+		Dispatch ().CmdBeginRenderPass ( commandBuffer , &pass_info , VK_SUBPASS_CONTENTS_INLINE );
+
+		return render_extent_;
+	}
+
+	void DynamicResolution::Upscale ( VkCommandBuffer commandBuffer , uint32_t frame , VkFramebuffer outputFramebuffer )
+	{
+		// the whole output is written, nothing to clear
+		VkRenderPassBeginInfo pass_info {};
+		pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		pass_info.renderPass = output_pass_;
+		pass_info.framebuffer = outputFramebuffer;
+		pass_info.renderArea.offset = { 0 , 0 };
+		pass_info.renderArea.extent = output_extent_;
+		VkClearValue clear_value {};
+		pass_info.clearValueCount = 1;
+		pass_info.pClearValues = &clear_value;
+		Dispatch ().CmdBeginRenderPass ( commandBuffer , &pass_info , VK_SUBPASS_CONTENTS_INLINE );
+
+		Dispatch ().CmdBindPipeline ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline_ );
+		upscale_state_.SetExtent ( output_extent_ );
+		CmdSetDynamicState ( commandBuffer , upscale_state_ );
+		Dispatch ().CmdBindDescriptorSets ( commandBuffer , VK_PIPELINE_BIND_POINT_GRAPHICS , pipeline_layout_ , 0 , 1 , &sets_[ frame ] , 0 , nullptr );
+
+		VkExtent2D const allocated = targets_.Extent ();
+		float const width = static_cast< float >( allocated.width );
+		float const height = static_cast< float >( allocated.height );
+		UpscaleConstants constants {
+			{ render_extent_.width / width , render_extent_.height / height } ,
+			{ ( render_extent_.width - 0.5f ) / width , ( render_extent_.height - 0.5f ) / height }
+		};
+		Dispatch ().CmdPushConstants ( commandBuffer , pipeline_layout_ , VK_SHADER_STAGE_FRAGMENT_BIT , 0 , sizeof ( constants ) , &constants );
+		Dispatch ().CmdDraw ( commandBuffer , 3 , 1 , 0 , 0 );
+
+		Dispatch ().CmdEndRenderPass ( commandBuffer );
+	}
+
+	void DynamicResolution::Retire ( GpuProfiler const& profiler , char const* zone )
+	{
+		// nothing when the frame's zone was not read back, zones sharing the name are summed
+		double elapsed_ms { 0.0 };
+		for ( auto const& timing : profiler.LastFrame () )
+		{
+			if ( std::strcmp ( timing.name_ , zone ) == 0 )
+			{
+				elapsed_ms += static_cast< double >( timing.end_ns_ - timing.begin_ns_ ) * 1e-6;
+			}
+		}
+		if ( elapsed_ms > 0.0 )
+		{
+			controller_.Update ( elapsed_ms );
+		}
+	}
+
+	ResolutionController const& DynamicResolution::Controller () const
+	{
+		return controller_;
+	}
+
+	void DynamicResolution::Destroy ()
+	{
+		// sets go back with their allocator, the set layout with the cache
+		DestroyTargets ();
+		vkDestroyPipeline ( logical_device_ , pipeline_ , nullptr );
+		vkDestroyPipelineLayout ( logical_device_ , pipeline_layout_ , nullptr );
+		vkDestroyRenderPass ( logical_device_ , scene_pass_ , nullptr );
+		vkDestroySampler ( logical_device_ , sampler_ , nullptr );
+		pipeline_ = VK_NULL_HANDLE;
+		pipeline_layout_ = VK_NULL_HANDLE;
+		scene_pass_ = VK_NULL_HANDLE;
+		sampler_ = VK_NULL_HANDLE;
+		sets_.clear ();
+		enabled_ = false;
+	}
+
+	bool DynamicResolution::CreateTargets ( VkExtent2D extent )
+	{
+		if ( !targets_.Initialize ( logical_device_ , physical_device_ , extent , format_ , frames_ ,
+									VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT ) )
+		{
+			return false;
+		}
+		views_ = Create::VKSwapchainImageViews ( logical_device_ , targets_.Images () , format_ );
+
+		framebuffers_.resize ( frames_ , VK_NULL_HANDLE );
+		for ( uint32_t i = 0; i < frames_; ++i )
+		{
+			VkFramebufferCreateInfo framebuffer_info {};
+			framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebuffer_info.renderPass = scene_pass_;
+			framebuffer_info.attachmentCount = 1;
+			framebuffer_info.pAttachments = &views_[ i ];
+			framebuffer_info.width = extent.width;
+			framebuffer_info.height = extent.height;
+			framebuffer_info.layers = 1;
+			if ( vkCreateFramebuffer ( logical_device_ , &framebuffer_info , nullptr , &framebuffers_[ i ] ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to create dynamic resolution framebuffer." );
+				return false;
+			}
+
+			VkDescriptorImageInfo image_info { sampler_ , views_[ i ] , VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+			VkWriteDescriptorSet write {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = sets_[ i ];
+			write.dstBinding = 0;
+			write.descriptorCount = 1;
+			write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			write.pImageInfo = &image_info;
+			vkUpdateDescriptorSets ( logical_device_ , 1 , &write , 0 , nullptr );
+		}
+		return true;
+	}
+
+	void DynamicResolution::DestroyTargets ()
+	{
+		for ( auto framebuffer : framebuffers_ )
+		{
+			vkDestroyFramebuffer ( logical_device_ , framebuffer , nullptr );
+		}
+		for ( auto view : views_ )
+		{
+			vkDestroyImageView ( logical_device_ , view , nullptr );
+		}
+		framebuffers_.clear ();
+		views_.clear ();
+		targets_.Destroy ();
+	}
+
+	bool DynamicResolution::CreateScenePass ( VkFormat format )
+	{
+		// only format and samples have to match the output pass for pipelines to be shared
+		VkAttachmentDescription color_attachment {};
+		color_attachment.format = format;
+		color_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		color_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		color_attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		VkAttachmentReference color_reference { 0 , VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+		VkSubpassDescription subpass {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &color_reference;
+
+		// the upscale pass samples what the scene wrote
+		VkSubpassDependency dependencies[ 2 ] = {};
+		dependencies[ 0 ].srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[ 0 ].dstSubpass = 0;
+		dependencies[ 0 ].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependencies[ 0 ].srcAccessMask = 0;
+		dependencies[ 0 ].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependencies[ 0 ].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		dependencies[ 1 ].srcSubpass = 0;
+		dependencies[ 1 ].dstSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[ 1 ].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependencies[ 1 ].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		dependencies[ 1 ].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		dependencies[ 1 ].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		VkRenderPassCreateInfo pass_info {};
+		pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		pass_info.attachmentCount = 1;
+		pass_info.pAttachments = &color_attachment;
+		pass_info.subpassCount = 1;
+		pass_info.pSubpasses = &subpass;
+		pass_info.dependencyCount = 2;
+		pass_info.pDependencies = dependencies;
+
+		if ( vkCreateRenderPass ( logical_device_ , &pass_info , nullptr , &scene_pass_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create dynamic resolution scene render pass." );
+			return false;
+		}
+		return true;
+	}
+
+	bool DynamicResolution::CreateUpscalePipeline ( VkPipelineCache pipelineCache , VkRenderPass outputPass , SPIRVView vertexShader , SPIRVView fragmentShader )
+	{
+		if ( vertexShader.Empty () || fragmentShader.Empty () )
+		{
+			Log ( LOG::ERROR , "Upscale shaders missing from the shader archive." );
+			return false;
+		}
+
+		VkPushConstantRange push_range { VK_SHADER_STAGE_FRAGMENT_BIT , 0 , sizeof ( UpscaleConstants ) };
+
+		VkPipelineLayoutCreateInfo layout_info {};
+		layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		layout_info.setLayoutCount = 1;
+		layout_info.pSetLayouts = &set_layout_;
+		layout_info.pushConstantRangeCount = 1;
+		layout_info.pPushConstantRanges = &push_range;
+		if ( vkCreatePipelineLayout ( logical_device_ , &layout_info , nullptr , &pipeline_layout_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create upscale pipeline layout." );
+			return false;
+		}
+
+		// modules are only needed until the pipeline is built
+		VkShaderModule modules[ 2 ] = { VK_NULL_HANDLE , VK_NULL_HANDLE };
+		SPIRVView const code[ 2 ] = { vertexShader , fragmentShader };
+		for ( int i = 0; i < 2; ++i )
+		{
+			VkShaderModuleCreateInfo module_info {};
+			module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+			module_info.codeSize = code[ i ].size_;
+			module_info.pCode = code[ i ].code_;
+			vkCreateShaderModule ( logical_device_ , &module_info , nullptr , &modules[ i ] );
+		}
+
+		VkPipelineShaderStageCreateInfo stages[ 2 ] = {};
+		stages[ 0 ].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages[ 0 ].stage = VK_SHADER_STAGE_VERTEX_BIT;
+		stages[ 0 ].module = modules[ 0 ];
+		stages[ 0 ].pName = "main";
+		stages[ 1 ].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages[ 1 ].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		stages[ 1 ].module = modules[ 1 ];
+		stages[ 1 ].pName = "main";
+
+		VkPipelineVertexInputStateCreateInfo vertex_input {};
+		vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+		VkPipelineInputAssemblyStateCreateInfo input_assembly {};
+		input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		input_assembly.topology = upscale_state_.topology_;
+
+		VkPipelineViewportStateCreateInfo viewport_state {};
+		viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewport_state.viewportCount = 1;
+		viewport_state.scissorCount = 1;
+
+		// the fullscreen triangle faces either way depending on the viewport
+		VkPipelineRasterizationStateCreateInfo rasterizer {};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.cullMode = VK_CULL_MODE_NONE;
+		rasterizer.frontFace = upscale_state_.front_face_;
+		rasterizer.lineWidth = 1.0f;
+
+		VkPipelineMultisampleStateCreateInfo multisampling {};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+		multisampling.minSampleShading = 1.0f;
+
+		VkPipelineDepthStencilStateCreateInfo depth_stencil {};
+		depth_stencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depth_stencil.depthCompareOp = upscale_state_.depth_compare_;
+
+		VkPipelineColorBlendAttachmentState blend_attachment {};
+		blend_attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+		VkPipelineColorBlendStateCreateInfo color_blend {};
+		color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		color_blend.attachmentCount = 1;
+		color_blend.pAttachments = &blend_attachment;
+
+		// same dynamic states as every other pipeline, set from upscale_state_
+		std::vector<VkDynamicState> dynamic_states = GetDynamicStates ( capabilities_ );
+		VkPipelineDynamicStateCreateInfo dynamic_state {};
+		dynamic_state.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamic_state.dynamicStateCount = static_cast< uint32_t >( dynamic_states.size () );
+		dynamic_state.pDynamicStates = dynamic_states.data ();
+
+		VkGraphicsPipelineCreateInfo pipeline_info {};
+		pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipeline_info.stageCount = 2;
+		pipeline_info.pStages = stages;
+		pipeline_info.pVertexInputState = &vertex_input;
+		pipeline_info.pInputAssemblyState = &input_assembly;
+		pipeline_info.pViewportState = &viewport_state;
+		pipeline_info.pRasterizationState = &rasterizer;
+		pipeline_info.pMultisampleState = &multisampling;
+		pipeline_info.pDepthStencilState = &depth_stencil;
+		pipeline_info.pColorBlendState = &color_blend;
+		pipeline_info.pDynamicState = &dynamic_state;
+		pipeline_info.layout = pipeline_layout_;
+		pipeline_info.renderPass = outputPass;
+		pipeline_info.subpass = 0;
+
+		VkResult const result = modules[ 0 ] != VK_NULL_HANDLE && modules[ 1 ] != VK_NULL_HANDLE
+			? vkCreateGraphicsPipelines ( logical_device_ , pipelineCache , 1 , &pipeline_info , nullptr , &pipeline_ )
+			: VK_ERROR_INITIALIZATION_FAILED;
+
+		vkDestroyShaderModule ( logical_device_ , modules[ 0 ] , nullptr );
+		vkDestroyShaderModule ( logical_device_ , modules[ 1 ] , nullptr );
+
+		if ( result != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to create upscale pipeline." );
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,135 @@
+/* RENDER RESOLUTION SCALED TO A GPU FRAME TIME TARGET */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "../tools/JZvk_DeviceContext.h"
+#include "../descriptors/JZvk_DescriptorLayoutCache.h"
+#include "../descriptors/JZvk_DescriptorAllocator.h"
+#include "../pipeline/JZvk_DynamicState.h"
+#include "../shaders/JZvk_ShaderArchive.h"
+#include "../swapchain/JZvk_OffscreenTargets.h"
+#include "../profiling/JZvk_GpuProfiler.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::ResolutionController___
+	 * **************************************************************
+	 * Picks a render scale from measured gpu frame times. Times are
+	 * smoothed, and the scale only moves once they leave a band just
+	 * under the target, by a bounded step per frame. GPU time is
+	 * taken to follow the pixel count, the square of the scale.
+	 * **************************************************************
+	*/
+	class ResolutionController
+	{
+	public:
+		void Configure ( double targetMs , float minScale , float maxScale );
+
+		// feeds one frame's gpu time, returns the scale for the frames after it
+		float Update ( double gpuMs );
+
+		float Scale () const;
+		double SmoothedMs () const;
+
+	private:
+		static constexpr double SMOOTHING = 0.1;	// weight of the newest frame
+		static constexpr double HEADROOM = 0.8;		// below target * HEADROOM the scale goes up
+		static constexpr double AIM = 0.9;			// changes aim for target * AIM, inside the band
+		static constexpr float MAX_STEP = 0.05f;	// relative scale change per frame
+
+		double target_ms_ { 16.0 };
+		float min_scale_ { 0.5f };
+		float max_scale_ { 1.0f };
+		float scale_ { 1.0f };
+		double smoothed_ms_ { 0.0 };
+	};
+
+	/*!
+	 * @brief ___JZvk::DynamicResolution___
+	 * **************************************************************
+	 * Renders the scene into an offscreen target per frame in
+	 * flight, allocated once at the output size. Only the top left
+	 * render extent, the output extent times the controller's scale,
+	 * is drawn, through the render area, viewport and scissor, so a
+	 * new scale never reallocates anything. An upscale pass then
+	 * samples that region bilinearly into the output framebuffer.
+	 *
+	 * The gpu time of each frame is a zone of the GpuProfiler, which
+	 * already times the passes, read once it has retired the frame,
+	 * see Retire(). Initialize() fails when the profiler is disabled,
+	 * on queues without timestamps.
+	 *
+	 * The scene render pass matches the output render pass in format
+	 * and samples, so pipelines built for one are compatible with the
+	 * other.
+	 * **************************************************************
+	*/
+	class DynamicResolution
+	{
+	public:
+		// gpu times come from profiler, which must be enabled
+		bool Initialize ( VkDevice logicalDevice , DeviceContext const& context , GpuProfiler const& profiler ,
+						  DescriptorLayoutCache& layoutCache , DescriptorAllocator& allocator , VkPipelineCache pipelineCache ,
+						  VkRenderPass outputPass , VkFormat format , VkExtent2D outputExtent , uint32_t framesInFlight ,
+						  SPIRVView vertexShader , SPIRVView fragmentShader , double targetMs , float minScale = 0.5f );
+
+		bool Enabled () const;
+
+		// whether outputExtent fits in the allocated targets
+		bool Fits ( VkExtent2D outputExtent ) const;
+
+		// new output size, targets are only recreated when it does not fit and the device must be idle then
+		bool Resize ( VkExtent2D outputExtent );
+
+		// begins the scene render pass, returns the render extent
+		VkExtent2D BeginScene ( VkCommandBuffer commandBuffer , uint32_t frame , VkClearValue clearValue );
+
+		// after the scene render pass has ended, draws it into outputFramebuffer of the output render pass
+		void Upscale ( VkCommandBuffer commandBuffer , uint32_t frame , VkFramebuffer outputFramebuffer );
+
+		// feeds the time of zone in the frame profiler retired last, call right after GpuProfiler::Retire()
+		void Retire ( GpuProfiler const& profiler , char const* zone );
+
+		ResolutionController const& Controller () const;
+
+		void Destroy ();
+
+	private:
+		bool CreateTargets ( VkExtent2D extent );
+		void DestroyTargets ();
+		bool CreateScenePass ( VkFormat format );
+		bool CreateUpscalePipeline ( VkPipelineCache pipelineCache , VkRenderPass outputPass , SPIRVView vertexShader , SPIRVView fragmentShader );
+
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkPhysicalDevice physical_device_ { VK_NULL_HANDLE };
+		DeviceCapabilities capabilities_;
+		VkFormat format_ { VK_FORMAT_UNDEFINED };
+		VkExtent2D output_extent_ { 0 , 0 };
+		VkExtent2D render_extent_ { 0 , 0 };
+		uint32_t frames_ { 0 };
+		bool enabled_ { false };
+
+		ResolutionController controller_;
+
+		// per frame in flight
+		OffscreenTargets targets_;
+		std::vector<VkImageView> views_;
+		std::vector<VkFramebuffer> framebuffers_;
+		std::vector<VkDescriptorSet> sets_;
+
+		VkRenderPass scene_pass_ { VK_NULL_HANDLE };
+		VkRenderPass output_pass_ { VK_NULL_HANDLE };
+		VkSampler sampler_ { VK_NULL_HANDLE };
+		VkDescriptorSetLayout set_layout_ { VK_NULL_HANDLE };
+		VkPipelineLayout pipeline_layout_ { VK_NULL_HANDLE };
+		VkPipeline pipeline_ { VK_NULL_HANDLE };
+		DynamicState upscale_state_;
+	};
+}
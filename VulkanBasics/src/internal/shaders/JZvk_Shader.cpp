@@ -0,0 +1,45 @@
+#include "JZvk_Shader.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+#ifdef JZVK_EMBED_SHADER_ARCHIVE
+// generated by ShaderCompiler -e, defines SHADER_ARCHIVE_WORDS
+#include "../../../shaders/shaders.jzsa.inl"
+#endif
+
+namespace JZvk
+{
+	namespace Shader
+	{
+		static ShaderArchive const& GetArchive ()
+		{
+			// function local static, opened once and safe to reach from several threads
+			static ShaderArchive archive;
+			static bool const opened = [] ()
+			{
+#ifdef JZVK_EMBED_SHADER_ARCHIVE
+				return archive.OpenMemory ( SHADER_ARCHIVE_WORDS , sizeof ( SHADER_ARCHIVE_WORDS ) );
+#else
+				return archive.Open ( ARCHIVE_PATH );
+#endif
+			}();
+
+			if ( !opened )
+			{
+				Log ( LOG::ERROR , "No shader archive, run shaders/compile first: " , ARCHIVE_PATH );
+			}
+			return archive;
+		}
+
+		SPIRVView Find ( std::string const& shaderName )
+		{
+			SPIRVView view = GetArchive ().Find ( shaderName );
+			if ( view.Empty () )
+			{
+				Log ( LOG::ERROR , "Shader not in archive: " , shaderName );
+			}
+			return view;
+		}
+	}
+}
@@ -0,0 +1,36 @@
+/* LOADS COMPILED SHADERS FROM THE PACKED SHADER ARCHIVE */
+#pragma once
+
+/* PROJECT INCLUDES */
+#include "JZvk_ShaderArchive.h"
+
+/* STD INCLUDES */
+#include <string>
+
+namespace JZvk
+{
+	namespace Shader
+	{
+		// written by ShaderCompiler, relative to the working directory
+		constexpr char const* ARCHIVE_PATH = "shaders/shaders.jzsa";
+		// same modules as compiled, neither optimized nor stripped, never loaded by the renderer
+		constexpr char const* BASELINE_ARCHIVE_PATH = "shaders/shaders.baseline.jzsa";
+
+		/*!
+		 * @brief ___JZvk::Shader::Find()___
+		 * **************************************************************
+		 * Looks up the SPIR-V module compiled from a shader source, e.g.
+		 * "shader.vert". On first use the archive is memory mapped from
+		 * ARCHIVE_PATH, or taken from the executable when built with
+		 * JZVK_EMBED_SHADER_ARCHIVE. The view points into the archive,
+		 * no copy is made.
+		 * **************************************************************
+		 * @param shaderName : std::string const&
+		 * : File name of the GLSL source the module was compiled from.
+		 * @return SPIRVView
+		 * : Module words and size, empty if not in the archive.
+		 * **************************************************************
+		*/
+		SPIRVView Find ( std::string const& shaderName );
+	}
+}
@@ -0,0 +1,179 @@
+#include "JZvk_ShaderArchive.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JZvk
+{
+	ShaderArchive::~ShaderArchive ()
+	{
+		Close ();
+	}
+
+	bool ShaderArchive::Open ( char const* path )
+	{
+		Close ();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA ( path , GENERIC_READ , FILE_SHARE_READ , nullptr , OPEN_EXISTING , FILE_ATTRIBUTE_NORMAL , nullptr );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			Log ( LOG::ERROR , "Failed to open shader archive " , path );
+			return false;
+		}
+
+		LARGE_INTEGER file_size;
+		GetFileSizeEx ( file , &file_size );
+		HANDLE mapping = CreateFileMappingA ( file , nullptr , PAGE_READONLY , 0 , 0 , nullptr );
+		void* view = mapping ? MapViewOfFile ( mapping , FILE_MAP_READ , 0 , 0 , 0 ) : nullptr;
+		if ( view == nullptr )
+		{
+			if ( mapping )
+			{
+				CloseHandle ( mapping );
+			}
+			CloseHandle ( file );
+			Log ( LOG::ERROR , "Failed to map shader archive " , path );
+			return false;
+		}
+
+		file_handle_ = file;
+		mapping_handle_ = mapping;
+		data_ = static_cast< unsigned char const* >( view );
+		size_ = static_cast< size_t >( file_size.QuadPart );
+#else
+		int file = open ( path , O_RDONLY );
+		if ( file < 0 )
+		{
+			Log ( LOG::ERROR , "Failed to open shader archive " , path );
+			return false;
+		}
+
+		struct stat file_stat;
+		fstat ( file , &file_stat );
+		void* view = mmap ( nullptr , static_cast< size_t >( file_stat.st_size ) , PROT_READ , MAP_PRIVATE , file , 0 );
+		// the mapping keeps its own reference to the file
+		close ( file );
+		if ( view == MAP_FAILED )
+		{
+			Log ( LOG::ERROR , "Failed to map shader archive " , path );
+			return false;
+		}
+
+		data_ = static_cast< unsigned char const* >( view );
+		size_ = static_cast< size_t >( file_stat.st_size );
+#endif
+		mapped_ = true;
+
+		if ( !Validate () )
+		{
+			Log ( LOG::ERROR , "Shader archive " , path , " is corrupt or from another version." );
+			Close ();
+			return false;
+		}
+		return true;
+	}
+
+	bool ShaderArchive::OpenMemory ( void const* data , size_t size )
+	{
+		Close ();
+		data_ = static_cast< unsigned char const* >( data );
+		size_ = size;
+		mapped_ = false;
+
+		if ( !Validate () )
+		{
+			Log ( LOG::ERROR , "Embedded shader archive is corrupt." );
+			Close ();
+			return false;
+		}
+		return true;
+	}
+
+	void ShaderArchive::Close ()
+	{
+		if ( mapped_ && data_ )
+		{
+#ifdef _WIN32
+			UnmapViewOfFile ( data_ );
+			CloseHandle ( static_cast< HANDLE >( mapping_handle_ ) );
+			CloseHandle ( static_cast< HANDLE >( file_handle_ ) );
+#else
+			munmap ( const_cast< unsigned char* >( data_ ) , size_ );
+#endif
+		}
+
+		data_ = nullptr;
+		size_ = 0;
+		entries_ = nullptr;
+		entry_count_ = 0;
+		file_handle_ = nullptr;
+		mapping_handle_ = nullptr;
+		mapped_ = false;
+	}
+
+	SPIRVView ShaderArchive::Find ( std::string const& shaderName ) const
+	{
+		// entries are sorted by name
+		ShaderArchiveEntry const* end = entries_ + entry_count_;
+		ShaderArchiveEntry const* entry = std::lower_bound ( entries_ , end , shaderName ,
+			[] ( ShaderArchiveEntry const& e , std::string const& name ) { return std::strcmp ( e.name_ , name.c_str () ) < 0; } );
+
+		if ( entry == end || shaderName != entry->name_ )
+		{
+			return {};
+		}
+		return { reinterpret_cast< uint32_t const* >( data_ + entry->offset_ ) , entry->size_ };
+	}
+
+	bool ShaderArchive::Validate ()
+	{
+		if ( size_ < sizeof ( ShaderArchiveHeader ) || reinterpret_cast< uintptr_t >( data_ ) % 4 != 0 )
+		{
+			return false;
+		}
+
+		ShaderArchiveHeader const* header = reinterpret_cast< ShaderArchiveHeader const* >( data_ );
+		if ( header->magic_ != SHADER_ARCHIVE_MAGIC || header->version_ != SHADER_ARCHIVE_VERSION || header->total_size_ > size_ )
+		{
+			return false;
+		}
+
+		size_t const table_end = sizeof ( ShaderArchiveHeader ) + size_t { header->entry_count_ } * sizeof ( ShaderArchiveEntry );
+		if ( table_end > size_ )
+		{
+			return false;
+		}
+
+		entries_ = reinterpret_cast< ShaderArchiveEntry const* >( data_ + sizeof ( ShaderArchiveHeader ) );
+		entry_count_ = header->entry_count_;
+
+		// bounds and alignment checked once here, so Find() can hand out views unchecked
+		for ( uint32_t i = 0; i < entry_count_; ++i )
+		{
+			ShaderArchiveEntry const& entry = entries_[ i ];
+			if ( entry.offset_ % 4 != 0 || entry.size_ % 4 != 0 || entry.offset_ < table_end
+				|| size_t { entry.offset_ } + entry.size_ > size_
+				|| std::memchr ( entry.name_ , '\0' , SHADER_ARCHIVE_NAME_SIZE ) == nullptr )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
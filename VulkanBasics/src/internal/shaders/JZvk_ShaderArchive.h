@@ -0,0 +1,92 @@
+/* PACKED SPIR-V ARCHIVE, MEMORY MAPPED ONCE AT STARTUP */
+#pragma once
+
+/* STD INCLUDES */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace JZvk
+{
+	/*!
+	 * ARCHIVE LAYOUT
+	 * ****************************************************************
+	 * ShaderArchiveHeader
+	 * ShaderArchiveEntry[ entry_count_ ], sorted by name
+	 * SPIR-V blobs, each starting on a 4 byte boundary
+	 *
+	 * All offsets are from the start of the archive. Written by
+	 * ShaderCompiler from the contents of the shader cache.
+	 * ****************************************************************
+	*/
+	constexpr uint32_t SHADER_ARCHIVE_MAGIC = 0x41535A4A;	// "JZSA"
+	constexpr uint32_t SHADER_ARCHIVE_VERSION = 1;
+	constexpr size_t SHADER_ARCHIVE_NAME_SIZE = 56;
+
+	struct ShaderArchiveHeader
+	{
+		uint32_t magic_;
+		uint32_t version_;
+		uint32_t entry_count_;
+		uint32_t total_size_;
+	};
+
+	struct ShaderArchiveEntry
+	{
+		char name_[ SHADER_ARCHIVE_NAME_SIZE ];	// null terminated source name, e.g. "shader.vert"
+		uint32_t offset_;
+		uint32_t size_;							// in bytes, a multiple of 4
+	};
+
+	static_assert( sizeof ( ShaderArchiveHeader ) % 4 == 0 && sizeof ( ShaderArchiveEntry ) % 4 == 0 , "archive blobs must stay 4 byte aligned" );
+
+	// non-owning view of a SPIR-V module, points into the archive mapping
+	struct SPIRVView
+	{
+		uint32_t const* code_ { nullptr };
+		size_t size_ { 0 };	// in bytes
+
+		bool Empty () const { return code_ == nullptr || size_ == 0; }
+	};
+
+	/*!
+	 * @brief ___JZvk::ShaderArchive___
+	 * **************************************************************
+	 * Read only view of a shader archive, either memory mapped from
+	 * a file or pointing at an archive embedded in the executable.
+	 * Views returned by Find() stay valid until the archive closes.
+	 * **************************************************************
+	*/
+	class ShaderArchive
+	{
+	public:
+		ShaderArchive () = default;
+		~ShaderArchive ();
+		ShaderArchive ( ShaderArchive const& ) = delete;
+		ShaderArchive& operator= ( ShaderArchive const& ) = delete;
+
+		bool Open ( char const* path );
+
+		// archive data already in memory, e.g. the embedded array, must outlive this object
+		bool OpenMemory ( void const* data , size_t size );
+
+		void Close ();
+
+		SPIRVView Find ( std::string const& shaderName ) const;
+
+		bool IsOpen () const { return data_ != nullptr; }
+
+	private:
+		bool Validate ();
+
+		unsigned char const* data_ { nullptr };
+		size_t size_ { 0 };
+		ShaderArchiveEntry const* entries_ { nullptr };
+		uint32_t entry_count_ { 0 };
+
+		// platform mapping handles, unused for memory archives
+		void* file_handle_ { nullptr };
+		void* mapping_handle_ { nullptr };
+		bool mapped_ { false };
+	};
+}
@@ -0,0 +1,132 @@
+#include "JZvk_ShaderPermutation.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+namespace JZvk
+{
+	VkSpecializationInfo const* SpecializationData::Info ()
+	{
+		info_.mapEntryCount = static_cast< uint32_t >( entries_.size () );
+		info_.pMapEntries = entries_.data ();
+		info_.dataSize = values_.size () * sizeof ( VkBool32 );
+		info_.pData = values_.data ();
+		return &info_;
+	}
+
+	void ShaderPermutations::DeclareSpecializedSwitch ( uint32_t constantId )
+	{
+		has_specialized_switch_ = true;
+		specialized_constant_id_ = constantId;
+	}
+
+	PermutationKey ShaderPermutations::DeclareFeature ( std::string const& name , uint32_t constantId )
+	{
+		if ( features_.size () >= sizeof ( PermutationKey ) * 8 )
+		{
+			Log ( LOG::ERROR , "Too many feature switches declared, ignoring " , name );
+			return 0;
+		}
+		features_.push_back ( { name , constantId } );
+		return PermutationKey { 1 } << ( features_.size () - 1 );
+	}
+
+	PermutationKey ShaderPermutations::FeatureBit ( std::string const& name ) const
+	{
+		for ( size_t i = 0; i < features_.size (); ++i )
+		{
+			if ( features_[ i ].name_ == name )
+			{
+				return PermutationKey { 1 } << i;
+			}
+		}
+		Log ( LOG::ERROR , "Unknown feature switch " , name );
+		return 0;
+	}
+
+	std::vector<PermutationKey> ShaderPermutations::AllKeys () const
+	{
+		std::vector<PermutationKey> keys ( size_t { 1 } << features_.size () );
+		for ( size_t i = 0; i < keys.size (); ++i )
+		{
+			keys[ i ] = static_cast< PermutationKey >( i );
+		}
+		return keys;
+	}
+
+	SpecializationData ShaderPermutations::Specialize ( PermutationKey key , bool specialized ) const
+	{
+		SpecializationData data;
+		if ( has_specialized_switch_ )
+		{
+			data.entries_.push_back ( { specialized_constant_id_ , 0 , sizeof ( VkBool32 ) } );
+			data.values_.push_back ( specialized ? VK_TRUE : VK_FALSE );
+		}
+
+		// unspecialized permutations keep the shader defaults and branch at runtime
+		if ( specialized )
+		{
+			for ( size_t i = 0; i < features_.size (); ++i )
+			{
+				uint32_t const offset = static_cast< uint32_t >( data.values_.size () * sizeof ( VkBool32 ) );
+				data.entries_.push_back ( { features_[ i ].constant_id_ , offset , sizeof ( VkBool32 ) } );
+				data.values_.push_back ( ( key >> i ) & 1u ? VK_TRUE : VK_FALSE );
+			}
+		}
+		return data;
+	}
+
+	void PermutationPipelines::Initialize ( VkDevice logicalDevice , VkPipelineCache pipelineCache , ShaderPermutations const* permutations , BuildFunction build )
+	{
+		logical_device_ = logicalDevice;
+		pipeline_cache_ = pipelineCache;
+		permutations_ = permutations;
+		build_ = std::move ( build );
+	}
+
+	VkPipeline PermutationPipelines::Get ( PermutationKey key , bool specialized )
+	{
+		// every runtime branching permutation is the same pipeline
+		uint64_t const id = specialized ? ( uint64_t { 1 } << 32 ) | key : 0;
+
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		auto it = pipelines_.find ( id );
+		if ( it != pipelines_.end () )
+		{
+			return it->second;
+		}
+
+		SpecializationData data = permutations_->Specialize ( key , specialized );
+		VkPipeline pipeline = build_ ( data.Info () , pipeline_cache_ );
+		if ( pipeline == VK_NULL_HANDLE )
+		{
+			if ( failed_.insert ( id ).second )
+			{
+				Log ( LOG::ERROR , "Failed to build pipeline permutation " , key , specialized ? ", specialized." : ", runtime branches." );
+			}
+			return VK_NULL_HANDLE;
+		}
+		failed_.erase ( id );
+		pipelines_.emplace ( id , pipeline );
+		return pipeline;
+	}
+
+	void PermutationPipelines::Prebuild ( std::vector<PermutationKey> const& keys , bool specialized )
+	{
+		for ( auto key : keys )
+		{
+			Get ( key , specialized );
+		}
+	}
+
+	void PermutationPipelines::Destroy ()
+	{
+		std::lock_guard<std::mutex> lock ( mutex_ );
+		for ( auto const& pipeline : pipelines_ )
+		{
+			vkDestroyPipeline ( logical_device_ , pipeline.second , nullptr );
+		}
+		pipelines_.clear ();
+		failed_.clear ();
+	}
+}
@@ -0,0 +1,111 @@
+/* FEATURE SWITCHES PER SHADER, MAPPED TO SPECIALIZATION CONSTANTS */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace JZvk
+{
+	// bit set of enabled feature switches, one bit per declared feature
+	using PermutationKey = uint32_t;
+
+	/*!
+	 * @brief ___JZvk::SpecializationData___
+	 * **************************************************************
+	 * Owns the map entries and constant values of one permutation.
+	 * Info() points into this object, so keep it alive until the
+	 * pipeline using it has been created.
+	 * **************************************************************
+	*/
+	struct SpecializationData
+	{
+		std::vector<VkSpecializationMapEntry> entries_;
+		std::vector<VkBool32> values_;
+		VkSpecializationInfo info_ {};
+
+		VkSpecializationInfo const* Info ();
+	};
+
+	/*!
+	 * @brief ___JZvk::ShaderPermutations___
+	 * **************************************************************
+	 * Declares the feature switches of a shader and the constant_id
+	 * each one maps to. Permutations are identified by a key with
+	 * one bit per feature, in declaration order.
+	 * **************************************************************
+	*/
+	class ShaderPermutations
+	{
+	public:
+		// constant_id of the switch that selects specialized over runtime branches,
+		// shaders without runtime branches leave it undeclared
+		void DeclareSpecializedSwitch ( uint32_t constantId );
+
+		// returns the key bit of the new feature
+		PermutationKey DeclareFeature ( std::string const& name , uint32_t constantId );
+
+		PermutationKey FeatureBit ( std::string const& name ) const;
+
+		// all 2^n keys, for building every permutation ahead of time
+		std::vector<PermutationKey> AllKeys () const;
+
+		SpecializationData Specialize ( PermutationKey key , bool specialized = true ) const;
+
+	private:
+		struct Feature
+		{
+			std::string name_;
+			uint32_t constant_id_;
+		};
+
+		std::vector<Feature> features_;
+		bool has_specialized_switch_ { false };
+		uint32_t specialized_constant_id_ { 0 };
+	};
+
+	/*!
+	 * @brief ___JZvk::PermutationPipelines___
+	 * **************************************************************
+	 * Pipelines for the permutations of a shader pair, created on
+	 * first use through the pipeline cache, or ahead of time with
+	 * Prebuild(). The build callback creates one pipeline from the
+	 * specialization info for both stages.
+	 *
+	 * Failed builds are not cached, Get() returns null and tries
+	 * again on the next call. Each failing permutation is logged once.
+	 * **************************************************************
+	*/
+	class PermutationPipelines
+	{
+	public:
+		using BuildFunction = std::function<VkPipeline ( VkSpecializationInfo const* , VkPipelineCache )>;
+
+		void Initialize ( VkDevice logicalDevice , VkPipelineCache pipelineCache , ShaderPermutations const* permutations , BuildFunction build );
+
+		VkPipeline Get ( PermutationKey key , bool specialized = true );
+
+		void Prebuild ( std::vector<PermutationKey> const& keys , bool specialized = true );
+
+		void Destroy ();
+
+	private:
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkPipelineCache pipeline_cache_ { VK_NULL_HANDLE };
+		ShaderPermutations const* permutations_ { nullptr };
+		BuildFunction build_;
+
+		std::mutex mutex_;
+		// keyed on (specialized << 32 | key)
+		std::unordered_map<uint64_t , VkPipeline> pipelines_;
+		// ids whose build failed and was logged
+		std::unordered_set<uint64_t> failed_;
+	};
+}
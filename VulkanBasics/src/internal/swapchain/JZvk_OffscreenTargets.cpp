@@ -0,0 +1,101 @@
+#include "JZvk_OffscreenTargets.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+#include "../memory/JZvk_Buffer.h"
+
+namespace JZvk
+{
+	bool OffscreenTargets::Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkExtent2D extent , VkFormat format , uint32_t count ,
+										VkImageUsageFlags usage )
+	{
+		logical_device_ = logicalDevice;
+		extent_ = extent;
+		format_ = format;
+
+		// software implementations do not render to every format a surface would offer
+		VkFormatProperties format_properties;
+		vkGetPhysicalDeviceFormatProperties ( physicalDevice , format , &format_properties );
+		if ( !( format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT ) )
+		{
+			Log ( LOG::ERROR , "Offscreen target format is not a color attachment format on this device." );
+			return false;
+		}
+
+		VkImageCreateInfo image_info {};
+		image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		image_info.imageType = VK_IMAGE_TYPE_2D;
+		image_info.format = format;
+		image_info.extent = { extent.width , extent.height , 1 };
+		image_info.mipLevels = 1;
+		image_info.arrayLayers = 1;
+		image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+		image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+		image_info.usage = usage;
+		image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		images_.resize ( count , VK_NULL_HANDLE );
+		for ( auto& image : images_ )
+		{
+			if ( vkCreateImage ( logicalDevice , &image_info , nullptr , &image ) != VK_SUCCESS )
+			{
+				Log ( LOG::ERROR , "Failed to create offscreen target image." );
+				Destroy ();
+				return false;
+			}
+		}
+
+		// identical images have identical requirements, each one takes an aligned slice
+		VkMemoryRequirements requirements;
+		vkGetImageMemoryRequirements ( logicalDevice , images_[ 0 ] , &requirements );
+		VkDeviceSize const slice = ( requirements.size + requirements.alignment - 1 ) / requirements.alignment * requirements.alignment;
+
+		VkMemoryAllocateInfo alloc_info {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		alloc_info.allocationSize = slice * count;
+		alloc_info.memoryTypeIndex = FindMemoryType ( physicalDevice , requirements.memoryTypeBits , VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+		if ( alloc_info.memoryTypeIndex == UINT32_MAX ||
+			vkAllocateMemory ( logicalDevice , &alloc_info , nullptr , &memory_ ) != VK_SUCCESS )
+		{
+			Log ( LOG::ERROR , "Failed to allocate offscreen target memory." );
+			Destroy ();
+			return false;
+		}
+		for ( uint32_t i = 0; i < count; ++i )
+		{
+			vkBindImageMemory ( logicalDevice , images_[ i ] , memory_ , slice * i );
+		}
+
+		Log ( LOG::INFO , "OFFSCREEN TARGETS" );
+		Log ( LOG::INFO , "\t" , count , " images, " , extent.width , "x" , extent.height , ", " , alloc_info.allocationSize , " bytes" );
+		return true;
+	}
+
+	std::vector<VkImage> const& OffscreenTargets::Images () const
+	{
+		return images_;
+	}
+
+	VkExtent2D OffscreenTargets::Extent () const
+	{
+		return extent_;
+	}
+
+	VkFormat OffscreenTargets::Format () const
+	{
+		return format_;
+	}
+
+	void OffscreenTargets::Destroy ()
+	{
+		for ( auto image : images_ )
+		{
+			vkDestroyImage ( logical_device_ , image , nullptr );
+		}
+		vkFreeMemory ( logical_device_ , memory_ , nullptr );
+		images_.clear ();
+		memory_ = VK_NULL_HANDLE;
+	}
+}
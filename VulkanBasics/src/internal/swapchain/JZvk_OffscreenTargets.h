@@ -0,0 +1,46 @@
+/* OFFSCREEN COLOR TARGETS STANDING IN FOR A SWAP CHAIN */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::OffscreenTargets___
+	 * **************************************************************
+	 * Color images for rendering without a window or surface, used
+	 * in place of swap chain images when running headless. All
+	 * images share one device local allocation and are created
+	 * with TRANSFER_SRC usage so frames can be read back.
+	 *
+	 * Nothing transitions the images for presentation, render
+	 * passes drawing into them should end in a layout the next
+	 * consumer expects instead of PRESENT_SRC_KHR.
+	 * **************************************************************
+	*/
+	class OffscreenTargets
+	{
+	public:
+		bool Initialize ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkExtent2D extent , VkFormat format , uint32_t count ,
+						  VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT );
+
+		// owned by the targets, image views are the caller's
+		std::vector<VkImage> const& Images () const;
+
+		VkExtent2D Extent () const;
+		VkFormat Format () const;
+
+		void Destroy ();
+
+	private:
+		VkDevice logical_device_ { VK_NULL_HANDLE };
+		VkDeviceMemory memory_ { VK_NULL_HANDLE };
+		std::vector<VkImage> images_;
+		VkExtent2D extent_ { 0 , 0 };
+		VkFormat format_ { VK_FORMAT_UNDEFINED };
+	};
+}
@@ -0,0 +1,86 @@
+#include "JZvk_PresentPolicy.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+
+namespace JZvk
+{
+	std::vector<VkPresentModeKHR> const& PresentModePreference ( PresentPolicy policy )
+	{
+		static std::vector<VkPresentModeKHR> const low_latency = { VK_PRESENT_MODE_MAILBOX_KHR , VK_PRESENT_MODE_FIFO_KHR };
+		static std::vector<VkPresentModeKHR> const vsync = { VK_PRESENT_MODE_FIFO_KHR };
+		static std::vector<VkPresentModeKHR> const adaptive = { VK_PRESENT_MODE_FIFO_RELAXED_KHR , VK_PRESENT_MODE_FIFO_KHR };
+		static std::vector<VkPresentModeKHR> const uncapped = { VK_PRESENT_MODE_IMMEDIATE_KHR , VK_PRESENT_MODE_MAILBOX_KHR , VK_PRESENT_MODE_FIFO_KHR };
+
+		switch ( policy )
+		{
+		case PresentPolicy::VSYNC:
+			return vsync;
+		case PresentPolicy::ADAPTIVE:
+			return adaptive;
+		case PresentPolicy::UNCAPPED:
+			return uncapped;
+		default:
+			return low_latency;
+		}
+	}
+
+	VkPresentModeKHR ChoosePresentMode ( PresentPolicy policy , std::vector<VkPresentModeKHR> const& availableModes )
+	{
+		for ( auto const mode : PresentModePreference ( policy ) )
+		{
+			if ( std::find ( availableModes.begin () , availableModes.end () , mode ) != availableModes.end () )
+			{
+				return mode;
+			}
+		}
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	char const* PresentPolicyName ( PresentPolicy policy )
+	{
+		switch ( policy )
+		{
+		case PresentPolicy::LOW_LATENCY:
+			return "lowlatency";
+		case PresentPolicy::VSYNC:
+			return "vsync";
+		case PresentPolicy::ADAPTIVE:
+			return "adaptive";
+		case PresentPolicy::UNCAPPED:
+			return "uncapped";
+		default:
+			return "unknown";
+		}
+	}
+
+	char const* PresentModeName ( VkPresentModeKHR presentMode )
+	{
+		switch ( presentMode )
+		{
+		case VK_PRESENT_MODE_IMMEDIATE_KHR:
+			return "IMMEDIATE";
+		case VK_PRESENT_MODE_MAILBOX_KHR:
+			return "MAILBOX";
+		case VK_PRESENT_MODE_FIFO_KHR:
+			return "FIFO";
+		case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+			return "FIFO_RELAXED";
+		default:
+			return "OTHER";
+		}
+	}
+
+	bool ParsePresentPolicy ( std::string const& name , PresentPolicy& policy )
+	{
+		for ( int i = 0; i < static_cast< int >( PresentPolicy::COUNT ); ++i )
+		{
+			if ( name == PresentPolicyName ( static_cast< PresentPolicy >( i ) ) )
+			{
+				policy = static_cast< PresentPolicy >( i );
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,47 @@
+/* PRESENT MODE SELECTION POLICIES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* STD INCLUDES */
+#include <string>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::PresentPolicy___
+	 * **************************************************************
+	 * What the swap chain's present mode is chosen for, each policy
+	 * is a preference list ending in FIFO, which every surface
+	 * supports.
+	 *
+	 * LOW_LATENCY	: MAILBOX, the previous hard coded choice
+	 * VSYNC		: FIFO
+	 * ADAPTIVE		: FIFO_RELAXED, late frames tear instead of waiting
+	 *				  for the next vertical blank
+	 * UNCAPPED		: IMMEDIATE then MAILBOX, frame rate only bound by
+	 *				  the frames in flight, for throughput measurements
+	 * **************************************************************
+	*/
+	enum class PresentPolicy
+	{
+		LOW_LATENCY ,
+		VSYNC ,
+		ADAPTIVE ,
+		UNCAPPED ,
+		COUNT
+	};
+
+	std::vector<VkPresentModeKHR> const& PresentModePreference ( PresentPolicy policy );
+
+	// first preferred mode in availableModes, FIFO when none are
+	VkPresentModeKHR ChoosePresentMode ( PresentPolicy policy , std::vector<VkPresentModeKHR> const& availableModes );
+
+	char const* PresentPolicyName ( PresentPolicy policy );
+
+	char const* PresentModeName ( VkPresentModeKHR presentMode );
+
+	// case sensitive match of PresentPolicyName, false if unknown
+	bool ParsePresentPolicy ( std::string const& name , PresentPolicy& policy );
+}
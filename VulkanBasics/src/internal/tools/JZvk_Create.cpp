@@ -2,8 +2,10 @@
 
 /* PROJECT INCLUDES */
 #include "../tools/JZvk_Support.h"
+#include "../tools/JZvk_DeviceSelection.h"
 #include "../debug/JZvk_Debug.h"
 #include "../debug/JZvk_Log.h"
+#include "../profiling/JZvk_CpuProfiler.h"
 
 /* STD INCLUDES */
 #include <cstdint>
@@ -16,18 +18,20 @@ namespace JZvk
 	{
 		GLFWwindow* GLFWWindow ( int width , int height , char const* title )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			// initialize glfw
 			glfwInit ();
 			// tell glfw not to create opengl window
 			glfwWindowHint ( GLFW_CLIENT_API , GLFW_NO_API );
-			// disable resize
-			glfwWindowHint ( GLFW_RESIZABLE , GLFW_FALSE );
+			// resizable, the swap chain is recreated when the framebuffer size changes
+			glfwWindowHint ( GLFW_RESIZABLE , GLFW_TRUE );
 			// create glfw window
 			return glfwCreateWindow ( width , height , title , nullptr , nullptr );
 		}
 
-		VkInstance VKInstance ( char const* appName , bool validationLayersEnabled )
+		VkInstance VKInstance ( char const* appName , bool validationLayersEnabled , bool windowSystem )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			if ( validationLayersEnabled && !CheckValidationLayerSupport () )
 			{
 				Log ( LOG::ERROR , "Creating instance, validation requested but not available." );
@@ -40,13 +44,16 @@ namespace JZvk
 			app_info.applicationVersion = VK_MAKE_VERSION ( 1 , 0 , 0 );
 			app_info.pEngineName		= "Engine";
 			app_info.engineVersion		= VK_MAKE_VERSION ( 1 , 0 , 0 );
-			app_info.apiVersion			= VK_API_VERSION_1_0;
+			app_info.apiVersion			= VK_API_VERSION_1_1;	// vkGetPhysicalDeviceFeatures2 is core in 1.1
 
 			// check glfw extensions and supported by vulkan
 			uint32_t glfw_extension_count = 0;
-			char const** glfw_extensions;
-			glfw_extensions = glfwGetRequiredInstanceExtensions ( &glfw_extension_count );
-			JZvk::CheckGLFWExtensionsSupport ( glfw_extensions , glfw_extension_count );
+			char const** glfw_extensions = nullptr;
+			if ( windowSystem )
+			{
+				glfw_extensions = glfwGetRequiredInstanceExtensions ( &glfw_extension_count );
+				JZvk::CheckGLFWExtensionsSupport ( glfw_extensions , glfw_extension_count );
+			}
 
 			VkInstanceCreateInfo create_info {};
 			create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -96,6 +103,7 @@ namespace JZvk
 
 		VkDebugUtilsMessengerEXT VKDebugMessenger ( VkInstance instance )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			VkDebugUtilsMessengerCreateInfoEXT debug_create_info {};
 			PopulateDebugMessengerCreateInfo ( debug_create_info );
 
@@ -110,6 +118,7 @@ namespace JZvk
 
 		VkSurfaceKHR VKSurface ( VkInstance instance , GLFWwindow* window )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			VkSurfaceKHR surface;
 			if ( glfwCreateWindowSurface ( instance , window , nullptr , &surface ) != VK_SUCCESS )
 			{
@@ -119,46 +128,43 @@ namespace JZvk
 			return surface;
 		}
 
-		VkPhysicalDevice VKPhysicalDevice ( VkInstance instance , VkSurfaceKHR surface )
+		VkPhysicalDevice VKPhysicalDevice ( VkInstance instance , VkSurfaceKHR surface , char const* pinnedDevice )
 		{
-			// pick a physical device
-			uint32_t device_count { 0 };
-			vkEnumeratePhysicalDevices ( instance , &device_count , nullptr );
-			if ( device_count == 0 )
+			JZVK_PROFILE_FUNCTION ();
+			// every device is enumerated and scored, the result stays cached for GetDeviceContext
+			std::vector<PhysicalDeviceInfo> const& devices = EnumeratePhysicalDevices ( instance , surface );
+			if ( devices.empty () )
 			{
 				Log ( LOG::ERROR , "Failed to find GPUs with Vulkan support." );
 			}
-			std::vector<VkPhysicalDevice> devices ( device_count );
-			vkEnumeratePhysicalDevices ( instance , &device_count , devices.data () );
 
 			// print all devices
 			Log ( LOG::INFO , "__________________________________________________" );
 			Log ( LOG::INFO , "SELECTING PHYSICAL DEVICE" );
 			Log ( LOG::INFO , "__________" );
 			Log ( LOG::INFO , "Physical Devices:" );
-			for ( auto const& physical_device : devices )
+			for ( size_t i = 0; i < devices.size (); ++i )
 			{
-				VkPhysicalDeviceProperties device_properties;
-				vkGetPhysicalDeviceProperties ( physical_device , &device_properties );
-				Log ( LOG::INFO , "\t" , device_properties.deviceName );
+				PhysicalDeviceInfo const& info = devices[ i ];
+				if ( info.suitable_ )
+				{
+					Log ( LOG::INFO , "\t" , i , ": " , info.properties_.deviceName , ", score " , info.score_ );
+				}
+				else
+				{
+					Log ( LOG::INFO , "\t" , i , ": " , info.properties_.deviceName , ", not suitable" );
+				}
 			}
 
 			Log ( LOG::INFO , "Suitable Device Found:" );
+			PhysicalDeviceInfo const* selected = SelectPhysicalDevice ( devices , pinnedDevice );
 			VkPhysicalDevice device_out { VK_NULL_HANDLE };
-			for ( auto const& physical_device : devices )
+			if ( selected != nullptr )
 			{
-				if ( IsDeviceSuitable ( physical_device , surface ) )
-				{
-					// device found
-					device_out = physical_device;
-					VkPhysicalDeviceProperties device_properties;
-					vkGetPhysicalDeviceProperties ( device_out , &device_properties );
-					Log ( LOG::INFO , "\t" , device_properties.deviceName );
-					break;
-				}
+				device_out = selected->device_;
+				Log ( LOG::INFO , "\t" , selected->properties_.deviceName );
 			}
-
-			if ( device_out == VK_NULL_HANDLE )
+			else
 			{
 				Log ( LOG::ERROR , "Failed to find a suitable GPU for selected operations." );
 			}
@@ -167,12 +173,18 @@ namespace JZvk
 			return device_out;
 		}
 
-		VkDevice VKLogicalDevice ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface , bool validationLayersEnabled  )
+		VkDevice VKLogicalDevice ( DeviceContext const& context , bool validationLayersEnabled  )
 		{
-			QueueFamilyIndices indices = FindQueueFamilies ( physicalDevice , surface );
+			JZVK_PROFILE_FUNCTION ();
+			QueueFamilyIndices const& indices = context.queue_family_indices_;
+			DeviceCapabilities const& capabilities = context.capabilities_;
 
-			// create set of queue families to guarantee unique key
-			std::set<uint32_t> unique_queue_families = { indices.graphics_family_.value (), indices.present_family_.value () };
+			// create set of queue families to guarantee unique key, headless devices have no present family
+			std::set<uint32_t> unique_queue_families = { indices.graphics_family_.value () };
+			if ( indices.present_family_.has_value () )
+			{
+				unique_queue_families.insert ( indices.present_family_.value () );
+			}
 
 			float queue_priority { 1.0f };
 
@@ -189,18 +201,57 @@ namespace JZvk
 				queue_create_infos.push_back ( queue_create_info );
 			}
 
-			// device features for logical device
-			VkPhysicalDeviceFeatures device_features {};
+			// device features for logical device, optional features are chained behind it
+			VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state {};
+			extended_dynamic_state.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+			extended_dynamic_state.extendedDynamicState = VK_TRUE;
+
+			// only what the bindless table needs, see GetDeviceCapabilities
+			VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing {};
+			descriptor_indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+			descriptor_indexing.runtimeDescriptorArray = VK_TRUE;
+			descriptor_indexing.descriptorBindingPartiallyBound = VK_TRUE;
+			descriptor_indexing.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			descriptor_indexing.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			descriptor_indexing.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+			descriptor_indexing.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			descriptor_indexing.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+
+			VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipeline_library {};
+			pipeline_library.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+			pipeline_library.graphicsPipelineLibrary = VK_TRUE;
+
+			VkPhysicalDeviceFeatures2 device_features {};
+			device_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			// core features, everything else stays off
+			device_features.features.pipelineStatisticsQuery = capabilities.pipeline_statistics_query_ ? VK_TRUE : VK_FALSE;
+			device_features.features.occlusionQueryPrecise = capabilities.occlusion_query_precise_ ? VK_TRUE : VK_FALSE;
+			if ( capabilities.extended_dynamic_state_ )
+			{
+				extended_dynamic_state.pNext = device_features.pNext;
+				device_features.pNext = &extended_dynamic_state;
+			}
+			if ( capabilities.descriptor_indexing_ )
+			{
+				descriptor_indexing.pNext = device_features.pNext;
+				device_features.pNext = &descriptor_indexing;
+			}
+			if ( capabilities.graphics_pipeline_library_ )
+			{
+				pipeline_library.pNext = device_features.pNext;
+				device_features.pNext = &pipeline_library;
+			}
 
 			// create logical device
-			std::vector<const char*> device_extensions = GetDeviceExtensions ();
+			std::vector<const char*> device_extensions = GetDeviceExtensions ( capabilities , !context.Headless () );
 			std::vector<const char*> validation_layers = GetValidationLayers ();
 
 			VkDeviceCreateInfo create_info {};
 			create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 			create_info.pQueueCreateInfos = queue_create_infos.data ();
 			create_info.queueCreateInfoCount = static_cast< uint32_t >( queue_create_infos.size () );
-			create_info.pEnabledFeatures = &device_features;
+			create_info.pNext = &device_features;
+			create_info.pEnabledFeatures = nullptr;
 			create_info.enabledExtensionCount = static_cast< uint32_t >( device_extensions.size () );
 			create_info.ppEnabledExtensionNames = device_extensions.data ();
 
@@ -215,7 +266,7 @@ namespace JZvk
 			}
 
 			VkDevice logical_device;
-			if ( vkCreateDevice ( physicalDevice , &create_info , nullptr , &logical_device ) != VK_SUCCESS )
+			if ( vkCreateDevice ( context.physical_device_ , &create_info , nullptr , &logical_device ) != VK_SUCCESS )
 			{
 				Log ( LOG::ERROR , "Failed to create logical device!" );
 			}
@@ -223,34 +274,36 @@ namespace JZvk
 			return logical_device;
 		}
 
-		VkQueue VKGraphicsQueue ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkQueue VKGraphicsQueue ( VkDevice logicalDevice , DeviceContext const& context )
 		{
-			QueueFamilyIndices indices = FindQueueFamilies ( physicalDevice , surface );
+			JZVK_PROFILE_FUNCTION ();
 			VkQueue graphics_queue;
-			vkGetDeviceQueue ( logicalDevice , indices.graphics_family_.value () , 0 , &graphics_queue );
+			vkGetDeviceQueue ( logicalDevice , context.queue_family_indices_.graphics_family_.value () , 0 , &graphics_queue );
 			return graphics_queue;
 		}
 
-		VkQueue VKPresentQueue ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkQueue VKPresentQueue ( VkDevice logicalDevice , DeviceContext const& context )
 		{
-			QueueFamilyIndices indices = FindQueueFamilies ( physicalDevice , surface );
+			JZVK_PROFILE_FUNCTION ();
 			VkQueue present_queue;
-			vkGetDeviceQueue ( logicalDevice , indices.present_family_.value () , 0 , &present_queue );
+			vkGetDeviceQueue ( logicalDevice , context.queue_family_indices_.present_family_.value () , 0 , &present_queue );
 			return present_queue;
 		}
 
-		VkSwapchainKHR VKSwapchain ( GLFWwindow* window , VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkSwapchainKHR VKSwapchain ( GLFWwindow* window , VkDevice logicalDevice , DeviceContext const& context ,
+									 VkSwapchainKHR oldSwapchain , PresentPolicy presentPolicy )
 		{
-			SwapChainSupportDetails swapchain_support = GetSwapChainSupport ( physicalDevice , surface );
+			JZVK_PROFILE_FUNCTION ();
+			SwapChainSupportDetails const& swapchain_support = context.swapchain_support_;
 
 			// get swap chain formats
-			VkSurfaceFormatKHR surface_format = VKSwapchainSurfaceFormat ( physicalDevice , surface );
+			VkSurfaceFormatKHR surface_format = VKSwapchainSurfaceFormat ( context );
 
 			// get swap chain present modes
-			VkPresentModeKHR present_mode = VKSwapchainPresentMode ( physicalDevice , surface );
+			VkPresentModeKHR present_mode = VKSwapchainPresentMode ( context , presentPolicy );
 
 			// get swap chain extent from capabilities
-			VkExtent2D swapchain_extent = VKSwapchainExtent2D ( window , physicalDevice , surface );
+			VkExtent2D swapchain_extent = VKSwapchainExtent2D ( window , context );
 
 			uint32_t image_count = swapchain_support.capabilities_.minImageCount + 1;
 
@@ -261,13 +314,14 @@ namespace JZvk
 
 			VkSwapchainCreateInfoKHR createInfo {};
 			createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-			createInfo.surface = surface;
+			createInfo.surface = context.surface_;
 			createInfo.minImageCount = image_count;
 			createInfo.imageFormat = surface_format.format;
 			createInfo.imageColorSpace = surface_format.colorSpace;
 			createInfo.imageExtent = swapchain_extent;
 			createInfo.imageArrayLayers = 1;
-			createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			// transfer source where the surface allows it, so presented frames can be read back
+			createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | ( swapchain_support.capabilities_.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT );
 			createInfo.presentMode = present_mode;
 			// transform of the image in the swap chain, e.g. rotation
 			createInfo.preTransform = swapchain_support.capabilities_.currentTransform;
@@ -275,10 +329,11 @@ namespace JZvk
 			createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 			// if true, pixels blocked by other windows are clipped
 			createInfo.clipped = VK_TRUE;
-			createInfo.oldSwapchain = VK_NULL_HANDLE;
+			// lets the driver hand resources of the replaced swap chain over to this one
+			createInfo.oldSwapchain = oldSwapchain;
 
 			// queue handling
-			QueueFamilyIndices indices = FindQueueFamilies ( physicalDevice , surface );
+			QueueFamilyIndices const& indices = context.queue_family_indices_;
 			uint32_t queueFamilyIndices[] = { indices.graphics_family_.value (), indices.present_family_.value () };
 			if ( indices.graphics_family_ != indices.present_family_ )
 			{
@@ -312,9 +367,10 @@ namespace JZvk
 			return swapchain;
 		}
 
-		VkSurfaceFormatKHR VKSwapchainSurfaceFormat ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkSurfaceFormatKHR VKSwapchainSurfaceFormat ( DeviceContext const& context )
 		{
-			std::vector<VkSurfaceFormatKHR> available_formats = GetSwapChainSupport ( physicalDevice , surface ).formats_;
+			JZVK_PROFILE_FUNCTION ();
+			std::vector<VkSurfaceFormatKHR> const& available_formats = context.swapchain_support_.formats_;
 			// if format specified found 
 			for ( auto const& available_format : available_formats )
 			{
@@ -327,24 +383,18 @@ namespace JZvk
 			return available_formats[ 0 ];
 		}
 
-		VkPresentModeKHR VKSwapchainPresentMode ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkPresentModeKHR VKSwapchainPresentMode ( DeviceContext const& context , PresentPolicy presentPolicy )
 		{
-			std::vector<VkPresentModeKHR> available_present_modes = GetSwapChainSupport ( physicalDevice , surface ).present_modes_;
-			// if present mode specified found 
-			for ( auto const& available_present_mode : available_present_modes )
-			{
-				if ( available_present_mode == VK_PRESENT_MODE_MAILBOX_KHR )
-				{
-					return available_present_mode;
-				}
-			}
-			// else return first in first out
-			return VK_PRESENT_MODE_FIFO_KHR;
+			JZVK_PROFILE_FUNCTION ();
+			std::vector<VkPresentModeKHR> const& available_present_modes = context.swapchain_support_.present_modes_;
+			// first mode of the policy the surface supports, else first in first out
+			return ChoosePresentMode ( presentPolicy , available_present_modes );
 		}
 
-		VkExtent2D VKSwapchainExtent2D ( GLFWwindow* window , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+		VkExtent2D VKSwapchainExtent2D ( GLFWwindow* window , DeviceContext const& context )
 		{
-			VkSurfaceCapabilitiesKHR capabilities = GetSwapChainSupport ( physicalDevice , surface ).capabilities_;
+			JZVK_PROFILE_FUNCTION ();
+			VkSurfaceCapabilitiesKHR const& capabilities = context.swapchain_support_.capabilities_;
 			if ( capabilities.currentExtent.width != UINT32_MAX )
 			{
 				return capabilities.currentExtent;
@@ -365,6 +415,7 @@ namespace JZvk
 
 		std::vector<VkImage> VKSwapchainImages ( VkDevice logicalDevice , VkSwapchainKHR swapchain )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			std::vector<VkImage> images;
 			uint32_t image_count { 0 };
 			vkGetSwapchainImagesKHR ( logicalDevice , swapchain , &image_count , nullptr );
@@ -375,6 +426,7 @@ namespace JZvk
 
 		std::vector<VkImageView> VKSwapchainImageViews ( VkDevice logicalDevice , std::vector<VkImage> const& swapchainImages , VkFormat swapchainImageFormat )
 		{
+			JZVK_PROFILE_FUNCTION ();
 			std::vector<VkImageView> image_views;
 			image_views.resize ( swapchainImages.size () );
 
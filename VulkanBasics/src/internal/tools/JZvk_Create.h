@@ -2,6 +2,11 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+/* PROJECT INCLUDES */
+#include "JZvk_Support.h"
+#include "JZvk_DeviceContext.h"
+#include "../swapchain/JZvk_PresentPolicy.h"
+
 /* STD INCLUDES */
 #include <vector>
 
@@ -11,28 +16,37 @@ namespace JZvk
 	{
 		GLFWwindow* GLFWWindow ( int width , int height , char const* title );
 
-		VkInstance VKInstance ( char const* appName , bool validationLayersEnabled = true );
+		// without windowSystem glfw is never touched and no surface extensions are enabled, for headless rendering
+		VkInstance VKInstance ( char const* appName , bool validationLayersEnabled = true , bool windowSystem = true );
 
 		VkDebugUtilsMessengerEXT VKDebugMessenger ( VkInstance instance );
 
 		VkSurfaceKHR VKSurface ( VkInstance instance , GLFWwindow* window );
 
-		VkPhysicalDevice VKPhysicalDevice ( VkInstance instance , VkSurfaceKHR surface );
+		// surface may be null when running headless
+		// highest scoring suitable device, unless pinnedDevice or JZVK_DEVICE names one, see SelectPhysicalDevice
+		VkPhysicalDevice VKPhysicalDevice ( VkInstance instance , VkSurfaceKHR surface , char const* pinnedDevice = nullptr );
+
+		// everything below takes the device's queries from context instead of repeating them, see GetDeviceContext
 
 		// logical device is a handle to the physical device
-		VkDevice VKLogicalDevice ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface , bool validationLayersEnabled = 0 );
+		// optional features in the context's capabilities are enabled along with their extensions
+		VkDevice VKLogicalDevice ( DeviceContext const& context , bool validationLayersEnabled = 0 );
 
-		VkQueue VKGraphicsQueue ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		VkQueue VKGraphicsQueue ( VkDevice logicalDevice , DeviceContext const& context );
 
-		VkQueue VKPresentQueue ( VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		VkQueue VKPresentQueue ( VkDevice logicalDevice , DeviceContext const& context );
 
-		VkSwapchainKHR VKSwapchain ( GLFWwindow* window , VkDevice logicalDevice , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		// oldSwapchain is retired by the new one, the caller still destroys it once no frame uses its images
+		// surface capabilities are taken as they are, refresh them first when the window changed
+		VkSwapchainKHR VKSwapchain ( GLFWwindow* window , VkDevice logicalDevice , DeviceContext const& context ,
+									 VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE , PresentPolicy presentPolicy = PresentPolicy::LOW_LATENCY );
 
-		VkSurfaceFormatKHR VKSwapchainSurfaceFormat ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		VkSurfaceFormatKHR VKSwapchainSurfaceFormat ( DeviceContext const& context );
 
-		VkPresentModeKHR VKSwapchainPresentMode ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		VkPresentModeKHR VKSwapchainPresentMode ( DeviceContext const& context , PresentPolicy presentPolicy = PresentPolicy::LOW_LATENCY );
 
-		VkExtent2D VKSwapchainExtent2D ( GLFWwindow* window , VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+		VkExtent2D VKSwapchainExtent2D ( GLFWwindow* window , DeviceContext const& context );
 
 		std::vector<VkImage> VKSwapchainImages ( VkDevice logicalDevice , VkSwapchainKHR swapchain );
 
@@ -0,0 +1,113 @@
+#include "JZvk_DeviceContext.h"
+
+/* PROJECT INCLUDES */
+#include "JZvk_DeviceSelection.h"
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+
+namespace JZvk
+{
+	DeviceContext GetDeviceContext ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
+	{
+		DeviceContext context;
+		context.physical_device_ = physicalDevice;
+		context.surface_ = surface;
+
+		// everything but the optional features was already enumerated when the device was picked
+		if ( PhysicalDeviceInfo const* info = FindPhysicalDeviceInfo ( physicalDevice , surface ) )
+		{
+			context.properties_ = info->properties_;
+			context.memory_properties_ = info->memory_properties_;
+			context.queue_families_ = info->queue_families_;
+			context.queue_family_indices_ = info->queue_family_indices_;
+			context.capabilities_ = GetDeviceCapabilities ( physicalDevice , info->extensions_ );
+			context.swapchain_support_ = info->swapchain_support_;
+		}
+		else
+		{
+			vkGetPhysicalDeviceProperties ( physicalDevice , &context.properties_ );
+			vkGetPhysicalDeviceMemoryProperties ( physicalDevice , &context.memory_properties_ );
+			CountQueryCalls ( 2 );
+
+			uint32_t family_count { 0 };
+			vkGetPhysicalDeviceQueueFamilyProperties ( physicalDevice , &family_count , nullptr );
+			context.queue_families_.resize ( family_count );
+			vkGetPhysicalDeviceQueueFamilyProperties ( physicalDevice , &family_count , context.queue_families_.data () );
+			CountQueryCalls ( 2 );
+
+			context.queue_family_indices_ = FindQueueFamilies ( physicalDevice , surface , context.queue_families_ );
+			context.capabilities_ = GetDeviceCapabilities ( physicalDevice );
+
+			if ( surface != VK_NULL_HANDLE )
+			{
+				context.swapchain_support_ = GetSwapChainSupport ( physicalDevice , surface );
+			}
+		}
+
+		Log ( LOG::INFO , "DEVICE CONTEXT" );
+		Log ( LOG::INFO , "\t" , context.properties_.deviceName , ", " , context.queue_families_.size () , " queue families, " ,
+			  context.swapchain_support_.formats_.size () , " surface formats, " , context.swapchain_support_.present_modes_.size () , " present modes" );
+		return context;
+	}
+
+	void RefreshSurfaceCapabilities ( DeviceContext& context )
+	{
+		if ( context.Headless () )
+		{
+			return;
+		}
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR ( context.physical_device_ , context.surface_ , &context.swapchain_support_.capabilities_ );
+		CountQueryCalls ( 1 );
+	}
+
+	// one FindQueueFamilies: both enumeration calls, then a surface support query per family
+	// up to the one that completed the indices, which is the larger of the two
+	static uint32_t QueueFamilyQueryCalls ( DeviceContext const& context )
+	{
+		QueueFamilyIndices const& indices = context.queue_family_indices_;
+		if ( context.Headless () || !indices.IsComplete () )
+		{
+			return 2 + ( context.Headless () ? 0 : static_cast< uint32_t >( context.queue_families_.size () ) );
+		}
+		return 2 + std::max ( indices.graphics_family_.value () , indices.present_family_.value () ) + 1;
+	}
+
+	// one GetSwapChainSupport, the second call of each list is skipped when it is empty
+	static uint32_t SwapChainSupportQueryCalls ( DeviceContext const& context )
+	{
+		SwapChainSupportDetails const& support = context.swapchain_support_;
+		return 3 + ( support.formats_.empty () ? 0 : 1 ) + ( support.present_modes_.empty () ? 0 : 1 );
+	}
+
+	PerCallQueryCount GetPerCallQueryCount ( DeviceContext const& context , bool dynamicResolution , bool frameReadback )
+	{
+		DeviceCapabilities const& capabilities = context.capabilities_;
+
+		// GetDeviceCapabilities enumerated the extensions twice per optional extension checked,
+		// graphics pipeline library only after pipeline library was found. the feature and
+		// property queries are the same either way
+		uint32_t const extension_checks = 4 + ( capabilities.graphics_pipeline_library_ ? 1 : 0 );
+		uint32_t const capability_queries = 1 + ( capabilities.descriptor_indexing_ ? 1 : 0 ) + ( capabilities.push_descriptor_ ? 1 : 0 )
+			+ ( capabilities.graphics_pipeline_library_ ? 1 : 0 );
+
+		uint32_t const queue_families = QueueFamilyQueryCalls ( context );
+		PerCallQueryCount count;
+		// VKLogicalDevice, VKGraphicsQueue and the command pool each found the queue families again
+		count.startup_ = 2 * extension_checks + capability_queries + 3 * queue_families;
+		if ( !context.Headless () )
+		{
+			uint32_t const swapchain_support = SwapChainSupportQueryCalls ( context );
+			// VKSwapchain found the queue families and queried the support itself and through its surface
+			// format, present mode and extent helpers, the renderer called the last three again
+			count.recreate_ = 7 * swapchain_support + queue_families;
+			// VKPresentQueue found the queue families once more
+			count.startup_ += count.recreate_ + queue_families;
+			count.startup_ += frameReadback ? swapchain_support : 0;
+		}
+		// the queue families, their properties and the device properties
+		count.startup_ += dynamicResolution ? queue_families + 3 : 0;
+		return count;
+	}
+}
@@ -0,0 +1,94 @@
+/* ONE TIME SNAPSHOT OF PHYSICAL DEVICE AND SURFACE QUERIES */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "JZvk_Support.h"
+
+/* STD INCLUDES */
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::DeviceContext___
+	 * **************************************************************
+	 * Everything the Create:: functions and the renderer query from
+	 * the selected physical device and surface, queried once by
+	 * GetDeviceContext() and passed around by reference instead of
+	 * being queried again by every function that needs it.
+	 *
+	 * Surface formats and present modes stay the same for the life
+	 * of a surface, only its capabilities follow the window, see
+	 * RefreshSurfaceCapabilities(). Without a surface the swap chain
+	 * support is left empty.
+	 * **************************************************************
+	*/
+	struct DeviceContext
+	{
+		VkPhysicalDevice physical_device_ { VK_NULL_HANDLE };
+		VkSurfaceKHR surface_ { VK_NULL_HANDLE };
+
+		VkPhysicalDeviceProperties properties_ {};
+		VkPhysicalDeviceMemoryProperties memory_properties_ {};
+		std::vector<VkQueueFamilyProperties> queue_families_;
+		QueueFamilyIndices queue_family_indices_;
+		DeviceCapabilities capabilities_;
+		SwapChainSupportDetails swapchain_support_ {};
+
+		bool Headless () const { return surface_ == VK_NULL_HANDLE; }
+	};
+
+	/*!
+	 * @brief ___JZvk::GetDeviceContext()___
+	 * **************************************************************
+	 * Runs every physical device, queue family and surface query of
+	 * the device once. surface may be null when running headless.
+	 * **************************************************************
+	 * @return DeviceContext
+	 * : Snapshot of the device and surface.
+	 * **************************************************************
+	*/
+	DeviceContext GetDeviceContext ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
+
+	/*!
+	 * @brief ___JZvk::RefreshSurfaceCapabilities()___
+	 * **************************************************************
+	 * Queries the surface capabilities again, their current extent
+	 * changes with the window. Call before recreating a swap chain.
+	 * **************************************************************
+	*/
+	void RefreshSurfaceCapabilities ( DeviceContext& context );
+
+	/*!
+	 * @brief ___JZvk::PerCallQueryCount___
+	 * **************************************************************
+	 * Query calls made after device selection when every Create::
+	 * function and renderer step queried the device and surface
+	 * itself, before DeviceContext. Worked out from the snapshot's
+	 * queue families, surface formats, present modes and optional
+	 * features, so traces can log it next to the QueryCallCount()
+	 * actually measured.
+	 * **************************************************************
+	*/
+	struct PerCallQueryCount
+	{
+		uint32_t startup_ { 0 };	// capabilities, logical device, queues, swap chain and command pool
+		uint32_t recreate_ { 0 };	// each swap chain recreate
+	};
+
+	/*!
+	 * @brief ___JZvk::GetPerCallQueryCount()___
+	 * **************************************************************
+	 * @param dynamicResolution : bool
+	 * : Dynamic resolution was initialized, it queried the graphics
+	 * queue family's timestamp bits.
+	 * @param frameReadback : bool
+	 * : Frame readback was created, it queried the swap chain image
+	 * usage of the surface.
+	 * @return PerCallQueryCount
+	 * **************************************************************
+	*/
+	PerCallQueryCount GetPerCallQueryCount ( DeviceContext const& context , bool dynamicResolution , bool frameReadback );
+}
@@ -0,0 +1,65 @@
+#include "JZvk_DeviceDispatch.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+namespace JZvk
+{
+	DeviceDispatch device_dispatch;
+
+	// keeps the exported function when the device has no such command
+	template <typename FUNCTION>
+	static void LoadCommand ( VkDevice logicalDevice , char const* name , FUNCTION& function )
+	{
+		FUNCTION const loaded = reinterpret_cast< FUNCTION >( vkGetDeviceProcAddr ( logicalDevice , name ) );
+		if ( loaded != nullptr )
+		{
+			function = loaded;
+		}
+	}
+
+	DeviceDispatch GetDeviceDispatch ( VkDevice logicalDevice )
+	{
+		DeviceDispatch dispatch;
+
+		LoadCommand ( logicalDevice , "vkCmdBeginRenderPass" , dispatch.CmdBeginRenderPass );
+		LoadCommand ( logicalDevice , "vkCmdEndRenderPass" , dispatch.CmdEndRenderPass );
+		LoadCommand ( logicalDevice , "vkCmdBindPipeline" , dispatch.CmdBindPipeline );
+		LoadCommand ( logicalDevice , "vkCmdBindDescriptorSets" , dispatch.CmdBindDescriptorSets );
+		LoadCommand ( logicalDevice , "vkCmdPushConstants" , dispatch.CmdPushConstants );
+		LoadCommand ( logicalDevice , "vkCmdDraw" , dispatch.CmdDraw );
+		LoadCommand ( logicalDevice , "vkCmdDrawIndexed" , dispatch.CmdDrawIndexed );
+		LoadCommand ( logicalDevice , "vkCmdSetViewport" , dispatch.CmdSetViewport );
+		LoadCommand ( logicalDevice , "vkCmdSetScissor" , dispatch.CmdSetScissor );
+		LoadCommand ( logicalDevice , "vkCmdPipelineBarrier" , dispatch.CmdPipelineBarrier );
+		LoadCommand ( logicalDevice , "vkCmdCopyImageToBuffer" , dispatch.CmdCopyImageToBuffer );
+		LoadCommand ( logicalDevice , "vkCmdResetQueryPool" , dispatch.CmdResetQueryPool );
+		LoadCommand ( logicalDevice , "vkCmdWriteTimestamp" , dispatch.CmdWriteTimestamp );
+		LoadCommand ( logicalDevice , "vkCmdBeginQuery" , dispatch.CmdBeginQuery );
+		LoadCommand ( logicalDevice , "vkCmdEndQuery" , dispatch.CmdEndQuery );
+
+		LoadCommand ( logicalDevice , "vkBeginCommandBuffer" , dispatch.BeginCommandBuffer );
+		LoadCommand ( logicalDevice , "vkEndCommandBuffer" , dispatch.EndCommandBuffer );
+		LoadCommand ( logicalDevice , "vkResetCommandBuffer" , dispatch.ResetCommandBuffer );
+		LoadCommand ( logicalDevice , "vkResetCommandPool" , dispatch.ResetCommandPool );
+		LoadCommand ( logicalDevice , "vkQueueSubmit" , dispatch.QueueSubmit );
+		LoadCommand ( logicalDevice , "vkWaitForFences" , dispatch.WaitForFences );
+		LoadCommand ( logicalDevice , "vkResetFences" , dispatch.ResetFences );
+		LoadCommand ( logicalDevice , "vkGetQueryPoolResults" , dispatch.GetQueryPoolResults );
+
+		LoadCommand ( logicalDevice , "vkAcquireNextImageKHR" , dispatch.AcquireNextImageKHR );
+		LoadCommand ( logicalDevice , "vkQueuePresentKHR" , dispatch.QueuePresentKHR );
+
+		LoadCommand ( logicalDevice , "vkAllocateDescriptorSets" , dispatch.AllocateDescriptorSets );
+		LoadCommand ( logicalDevice , "vkUpdateDescriptorSets" , dispatch.UpdateDescriptorSets );
+		LoadCommand ( logicalDevice , "vkUpdateDescriptorSetWithTemplate" , dispatch.UpdateDescriptorSetWithTemplate );
+		LoadCommand ( logicalDevice , "vkResetDescriptorPool" , dispatch.ResetDescriptorPool );
+
+		return dispatch;
+	}
+
+	void LoadDeviceDispatch ( VkDevice logicalDevice )
+	{
+		device_dispatch = GetDeviceDispatch ( logicalDevice );
+	}
+}
@@ -0,0 +1,92 @@
+/* DEVICE LEVEL COMMANDS LOADED STRAIGHT FROM THE DRIVER */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::DeviceDispatch___
+	 * **************************************************************
+	 * Device level commands the renderer calls every frame. The
+	 * functions exported by vulkan-1 are loader trampolines that
+	 * look up the device's dispatch table on every call, pointers
+	 * from vkGetDeviceProcAddr go to the driver, or the first
+	 * enabled layer, directly.
+	 *
+	 * Default constructed, every member is the exported function,
+	 * so the table can be called before LoadDeviceDispatch() and
+	 * compared against the loaded one.
+	 * **************************************************************
+	*/
+	struct DeviceDispatch
+	{
+		// command buffer recording
+		PFN_vkCmdBeginRenderPass CmdBeginRenderPass { ::vkCmdBeginRenderPass };
+		PFN_vkCmdEndRenderPass CmdEndRenderPass { ::vkCmdEndRenderPass };
+		PFN_vkCmdBindPipeline CmdBindPipeline { ::vkCmdBindPipeline };
+		PFN_vkCmdBindDescriptorSets CmdBindDescriptorSets { ::vkCmdBindDescriptorSets };
+		PFN_vkCmdPushConstants CmdPushConstants { ::vkCmdPushConstants };
+		PFN_vkCmdDraw CmdDraw { ::vkCmdDraw };
+		PFN_vkCmdDrawIndexed CmdDrawIndexed { ::vkCmdDrawIndexed };
+		PFN_vkCmdSetViewport CmdSetViewport { ::vkCmdSetViewport };
+		PFN_vkCmdSetScissor CmdSetScissor { ::vkCmdSetScissor };
+		PFN_vkCmdPipelineBarrier CmdPipelineBarrier { ::vkCmdPipelineBarrier };
+		PFN_vkCmdCopyImageToBuffer CmdCopyImageToBuffer { ::vkCmdCopyImageToBuffer };
+		PFN_vkCmdResetQueryPool CmdResetQueryPool { ::vkCmdResetQueryPool };
+		PFN_vkCmdWriteTimestamp CmdWriteTimestamp { ::vkCmdWriteTimestamp };
+		PFN_vkCmdBeginQuery CmdBeginQuery { ::vkCmdBeginQuery };
+		PFN_vkCmdEndQuery CmdEndQuery { ::vkCmdEndQuery };
+
+		// command buffers, submission and synchronization
+		PFN_vkBeginCommandBuffer BeginCommandBuffer { ::vkBeginCommandBuffer };
+		PFN_vkEndCommandBuffer EndCommandBuffer { ::vkEndCommandBuffer };
+		PFN_vkResetCommandBuffer ResetCommandBuffer { ::vkResetCommandBuffer };
+		PFN_vkResetCommandPool ResetCommandPool { ::vkResetCommandPool };
+		PFN_vkQueueSubmit QueueSubmit { ::vkQueueSubmit };
+		PFN_vkWaitForFences WaitForFences { ::vkWaitForFences };
+		PFN_vkResetFences ResetFences { ::vkResetFences };
+		PFN_vkGetQueryPoolResults GetQueryPoolResults { ::vkGetQueryPoolResults };
+
+		// swap chain, left as the exported functions on devices without the extension
+		PFN_vkAcquireNextImageKHR AcquireNextImageKHR { ::vkAcquireNextImageKHR };
+		PFN_vkQueuePresentKHR QueuePresentKHR { ::vkQueuePresentKHR };
+
+		// per frame descriptor sets
+		PFN_vkAllocateDescriptorSets AllocateDescriptorSets { ::vkAllocateDescriptorSets };
+		PFN_vkUpdateDescriptorSets UpdateDescriptorSets { ::vkUpdateDescriptorSets };
+		PFN_vkUpdateDescriptorSetWithTemplate UpdateDescriptorSetWithTemplate { ::vkUpdateDescriptorSetWithTemplate };
+		PFN_vkResetDescriptorPool ResetDescriptorPool { ::vkResetDescriptorPool };
+	};
+
+	/*!
+	 * @brief ___JZvk::GetDeviceDispatch()___
+	 * **************************************************************
+	 * Loads every command of DeviceDispatch with vkGetDeviceProcAddr.
+	 * Commands the device does not expose keep the exported function.
+	 * **************************************************************
+	 * @return DeviceDispatch
+	 * : Table pointing past the loader.
+	 * **************************************************************
+	*/
+	DeviceDispatch GetDeviceDispatch ( VkDevice logicalDevice );
+
+	/*!
+	 * @brief ___JZvk::LoadDeviceDispatch()___
+	 * **************************************************************
+	 * Loads the table returned by Dispatch(). Call once after the
+	 * logical device is created, before anything records commands
+	 * on another thread.
+	 * **************************************************************
+	*/
+	void LoadDeviceDispatch ( VkDevice logicalDevice );
+
+	// see Dispatch, defined in JZvk_DeviceDispatch.cpp
+	extern DeviceDispatch device_dispatch;
+
+	// the table hot paths call through, the exported functions until LoadDeviceDispatch
+	inline DeviceDispatch const& Dispatch ()
+	{
+		return device_dispatch;
+	}
+}
@@ -0,0 +1,219 @@
+#include "JZvk_DeviceSelection.h"
+
+/* PROJECT INCLUDES */
+#include "../debug/JZvk_Log.h"
+
+/* STD INCLUDES */
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+namespace JZvk
+{
+	static std::vector<PhysicalDeviceInfo>& DeviceCache ()
+	{
+		static std::vector<PhysicalDeviceInfo> devices;
+		return devices;
+	}
+
+	// empty when not set, getenv is deprecated under msvc's sdl checks
+	static std::string ReadEnvironment ( char const* name )
+	{
+#ifdef _WIN32
+		char* value { nullptr };
+		size_t length { 0 };
+		std::string result;
+		if ( _dupenv_s ( &value , &length , name ) == 0 && value != nullptr )
+		{
+			result = value;
+		}
+		std::free ( value );
+		return result;
+#else
+		char const* value = std::getenv ( name );
+		return value != nullptr ? value : "";
+#endif
+	}
+
+	static std::string Lowercase ( std::string text )
+	{
+		std::transform ( text.begin () , text.end () , text.begin () , [] ( unsigned char c ) { return static_cast< char >( std::tolower ( c ) ); } );
+		return text;
+	}
+
+	int64_t ScorePhysicalDevice ( PhysicalDeviceInfo const& info )
+	{
+		if ( !info.suitable_ )
+		{
+			return -1;
+		}
+
+		// the type outweighs everything else, an integrated gpu never beats a discrete one on memory or features
+		int64_t score { 0 };
+		switch ( info.properties_.deviceType )
+		{
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:	 score += 100000; break;
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: score += 40000; break;
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:	 score += 20000; break;
+		case VK_PHYSICAL_DEVICE_TYPE_CPU:			 score += 5000; break;
+		default: break;
+		}
+
+		// 4 points per 64 MiB of the largest device local heap, up to 64 GiB
+		VkDeviceSize largest_heap { 0 };
+		for ( uint32_t i = 0; i < info.memory_properties_.memoryHeapCount; ++i )
+		{
+			VkMemoryHeap const& heap = info.memory_properties_.memoryHeaps[ i ];
+			if ( heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT )
+			{
+				largest_heap = std::max ( largest_heap , heap.size );
+			}
+		}
+		score += 4 * static_cast< int64_t >( std::min<VkDeviceSize> ( largest_heap >> 26 , 1024 ) );
+
+		// queues that can run alongside graphics, once each
+		bool async_compute { false };
+		bool async_transfer { false };
+		for ( auto const& family : info.queue_families_ )
+		{
+			async_compute = async_compute || ( ( family.queueFlags & VK_QUEUE_COMPUTE_BIT ) && !( family.queueFlags & VK_QUEUE_GRAPHICS_BIT ) );
+			async_transfer = async_transfer || ( ( family.queueFlags & VK_QUEUE_TRANSFER_BIT ) && !( family.queueFlags & ( VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT ) ) );
+		}
+		score += async_compute ? 2000 : 0;
+		score += async_transfer ? 2000 : 0;
+
+		uint32_t const graphics_family = info.queue_family_indices_.graphics_family_.value ();
+		score += info.queue_families_[ graphics_family ].timestampValidBits > 0 ? 2000 : 0;
+		// one family for both means exclusive swap chain images
+		score += info.queue_family_indices_.present_family_ == info.queue_family_indices_.graphics_family_ ? 1000 : 0;
+
+		// optional extensions the renderer uses when present, see GetDeviceCapabilities
+		char const* const optional_extensions[] = {
+			VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME ,
+			VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME ,
+			VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME ,
+			VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME
+		};
+		for ( char const* extension : optional_extensions )
+		{
+			score += HasExtension ( info.extensions_ , extension ) ? 1500 : 0;
+		}
+
+		// limits, small enough to only break ties
+		score += info.properties_.limits.maxImageDimension2D / 64;
+		score += std::min ( info.properties_.limits.maxPushConstantsSize , 256u );
+		return score;
+	}
+
+	std::vector<PhysicalDeviceInfo> const& EnumeratePhysicalDevices ( VkInstance instance , VkSurfaceKHR surface )
+	{
+		uint32_t device_count { 0 };
+		vkEnumeratePhysicalDevices ( instance , &device_count , nullptr );
+		std::vector<VkPhysicalDevice> handles ( device_count );
+		vkEnumeratePhysicalDevices ( instance , &device_count , handles.data () );
+		CountQueryCalls ( 2 );
+
+		std::vector<PhysicalDeviceInfo>& devices = DeviceCache ();
+		devices.clear ();
+		devices.resize ( device_count );
+		for ( uint32_t i = 0; i < device_count; ++i )
+		{
+			PhysicalDeviceInfo& info = devices[ i ];
+			info.device_ = handles[ i ];
+			info.surface_ = surface;
+
+			vkGetPhysicalDeviceProperties ( info.device_ , &info.properties_ );
+			vkGetPhysicalDeviceMemoryProperties ( info.device_ , &info.memory_properties_ );
+
+			uint32_t family_count { 0 };
+			vkGetPhysicalDeviceQueueFamilyProperties ( info.device_ , &family_count , nullptr );
+			info.queue_families_.resize ( family_count );
+			vkGetPhysicalDeviceQueueFamilyProperties ( info.device_ , &family_count , info.queue_families_.data () );
+			CountQueryCalls ( 4 );
+
+			info.extensions_ = EnumerateDeviceExtensions ( info.device_ );
+			info.queue_family_indices_ = FindQueueFamilies ( info.device_ , surface , info.queue_families_ );
+
+			// same requirements as IsDeviceSuitable, from what was just enumerated
+			if ( surface == VK_NULL_HANDLE )
+			{
+				info.suitable_ = info.queue_family_indices_.graphics_family_.has_value () && CheckDeviceExtensionsSupport ( info.extensions_ , false );
+			}
+			else
+			{
+				info.suitable_ = info.queue_family_indices_.IsComplete () && CheckDeviceExtensionsSupport ( info.extensions_ );
+				if ( info.suitable_ )
+				{
+					info.swapchain_support_ = GetSwapChainSupport ( info.device_ , surface );
+					info.suitable_ = !info.swapchain_support_.formats_.empty () && !info.swapchain_support_.present_modes_.empty ();
+				}
+			}
+			info.score_ = ScorePhysicalDevice ( info );
+		}
+		return devices;
+	}
+
+	PhysicalDeviceInfo const* SelectPhysicalDevice ( std::vector<PhysicalDeviceInfo> const& devices , char const* pinnedDevice )
+	{
+		std::string const pin = pinnedDevice != nullptr && pinnedDevice[ 0 ] != '\0' ? std::string ( pinnedDevice ) : ReadEnvironment ( DEVICE_OVERRIDE_ENV );
+
+		PhysicalDeviceInfo const* best { nullptr };
+		for ( auto const& info : devices )
+		{
+			if ( info.suitable_ && ( best == nullptr || info.score_ > best->score_ ) )
+			{
+				best = &info;
+			}
+		}
+		if ( pin.empty () )
+		{
+			return best;
+		}
+
+		// an index in enumeration order, else part of the name
+		PhysicalDeviceInfo const* pinned { nullptr };
+		bool const is_index = std::all_of ( pin.begin () , pin.end () , [] ( unsigned char c ) { return std::isdigit ( c ) != 0; } );
+		if ( is_index )
+		{
+			size_t const index = std::strtoul ( pin.c_str () , nullptr , 10 );
+			pinned = index < devices.size () ? &devices[ index ] : nullptr;
+		}
+		else
+		{
+			std::string const name = Lowercase ( pin );
+			for ( auto const& info : devices )
+			{
+				if ( Lowercase ( info.properties_.deviceName ).find ( name ) != std::string::npos )
+				{
+					pinned = &info;
+					break;
+				}
+			}
+		}
+
+		if ( pinned == nullptr )
+		{
+			Log ( LOG::ERROR , "No physical device matches " , pin , ", selecting by score." );
+			return best;
+		}
+		if ( !pinned->suitable_ )
+		{
+			Log ( LOG::ERROR , "Pinned physical device " , pinned->properties_.deviceName , " is not suitable, selecting by score." );
+			return best;
+		}
+		return pinned;
+	}
+
+	PhysicalDeviceInfo const* FindPhysicalDeviceInfo ( VkPhysicalDevice device , VkSurfaceKHR surface )
+	{
+		for ( auto const& info : DeviceCache () )
+		{
+			if ( info.device_ == device && info.surface_ == surface )
+			{
+				return &info;
+			}
+		}
+		return nullptr;
+	}
+}
@@ -0,0 +1,86 @@
+/* SCORES EVERY PHYSICAL DEVICE AND PICKS ONE, KEEPING WHAT WAS ENUMERATED */
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+/* PROJECT INCLUDES */
+#include "JZvk_Support.h"
+
+/* STD INCLUDES */
+#include <cstdint>
+#include <vector>
+
+namespace JZvk
+{
+	// names a device to use regardless of score, an index in enumeration order or part of the device name
+	constexpr char const* DEVICE_OVERRIDE_ENV = "JZVK_DEVICE";
+
+	/*!
+	 * @brief ___JZvk::PhysicalDeviceInfo___
+	 * **************************************************************
+	 * Everything enumerated about one physical device while picking
+	 * one, kept so the rest of startup does not query it again, see
+	 * FindPhysicalDeviceInfo(). Swap chain support is only filled
+	 * when selecting against a surface.
+	 * **************************************************************
+	*/
+	struct PhysicalDeviceInfo
+	{
+		VkPhysicalDevice device_ { VK_NULL_HANDLE };
+		VkPhysicalDeviceProperties properties_ {};
+		VkPhysicalDeviceMemoryProperties memory_properties_ {};
+		std::vector<VkQueueFamilyProperties> queue_families_;
+		std::vector<VkExtensionProperties> extensions_;
+		QueueFamilyIndices queue_family_indices_;
+		SwapChainSupportDetails swapchain_support_ {};
+		VkSurfaceKHR surface_ { VK_NULL_HANDLE };
+
+		bool suitable_ { false };
+		int64_t score_ { -1 };		// -1 when not suitable
+	};
+
+	/*!
+	 * @brief ___JZvk::ScorePhysicalDevice()___
+	 * **************************************************************
+	 * Higher is better. Device type weighs the most, then the size
+	 * of the largest device local heap, then dedicated compute and
+	 * transfer queues, timestamps on the graphics queue, present
+	 * on the graphics family, the optional extensions the renderer
+	 * makes use of and a few limits. Unsuitable devices score -1.
+	 * **************************************************************
+	 * @return int64_t
+	 * : Score of the device.
+	 * **************************************************************
+	*/
+	int64_t ScorePhysicalDevice ( PhysicalDeviceInfo const& info );
+
+	/*!
+	 * @brief ___JZvk::EnumeratePhysicalDevices()___
+	 * **************************************************************
+	 * Enumerates and scores every physical device of the instance.
+	 * The result is cached for FindPhysicalDeviceInfo(), enumerating
+	 * again replaces the cache.
+	 * **************************************************************
+	 * @return std::vector<PhysicalDeviceInfo> const&
+	 * : Every device, in enumeration order.
+	 * **************************************************************
+	*/
+	std::vector<PhysicalDeviceInfo> const& EnumeratePhysicalDevices ( VkInstance instance , VkSurfaceKHR surface );
+
+	/*!
+	 * @brief ___JZvk::SelectPhysicalDevice()___
+	 * **************************************************************
+	 * The highest scoring suitable device, or the one named by
+	 * pinnedDevice, or by DEVICE_OVERRIDE_ENV when pinnedDevice is
+	 * null or empty. A pin matching no suitable device is logged
+	 * and falls back to the score.
+	 * **************************************************************
+	 * @return PhysicalDeviceInfo const*
+	 * : Selected device, null if none is suitable.
+	 * **************************************************************
+	*/
+	PhysicalDeviceInfo const* SelectPhysicalDevice ( std::vector<PhysicalDeviceInfo> const& devices , char const* pinnedDevice = nullptr );
+
+	// cached info of device when it was enumerated against surface, else null
+	PhysicalDeviceInfo const* FindPhysicalDeviceInfo ( VkPhysicalDevice device , VkSurfaceKHR surface );
+}
@@ -0,0 +1,166 @@
+#include "JZvk_StartupGraph.h"
+
+/* PROJECT INCLUDES */
+#include "../profiling/JZvk_CpuProfiler.h"
+
+/* STD INCLUDES */
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace JZvk
+{
+	StartupGraph::Step StartupGraph::Add ( std::string name , std::function<void ()> task , std::vector<Step> dependencies , Thread thread )
+	{
+		for ( Step dependency : dependencies )
+		{
+			if ( dependency >= steps_.size () )
+			{
+				throw std::runtime_error ( "startup step depends on a step added after it!" );
+			}
+		}
+		Node node;
+		node.name_ = std::move ( name );
+		node.task_ = std::move ( task );
+		node.dependencies_ = std::move ( dependencies );
+		node.thread_ = thread;
+		steps_.push_back ( std::move ( node ) );
+		return steps_.size () - 1;
+	}
+
+	void StartupGraph::Run ()
+	{
+		using Clock = std::chrono::steady_clock;
+		Clock::time_point const start = Clock::now ();
+		auto elapsed_ms = [ start ] ()
+		{
+			return std::chrono::duration<double , std::milli> ( Clock::now () - start ).count ();
+		};
+
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::vector<std::thread> workers;
+		std::exception_ptr error;
+		size_t running { 0 };
+
+		// runs one step and records it, called with the lock released
+		auto execute = [ & ] ( Node& node )
+		{
+			JZVK_PROFILE_ZONE ( Profiler::Intern ( node.name_ ) );
+			double const step_start = elapsed_ms ();
+			std::exception_ptr step_error;
+			try
+			{
+				node.task_ ();
+			}
+			catch ( ... )
+			{
+				step_error = std::current_exception ();
+			}
+
+			std::lock_guard<std::mutex> lock ( mutex );
+			node.start_ms_ = step_start;
+			node.duration_ms_ = elapsed_ms () - step_start;
+			node.done_ = true;
+			if ( step_error && !error )
+			{
+				error = step_error;
+			}
+			--running;
+			finished.notify_all ();
+		};
+
+		std::unique_lock<std::mutex> lock ( mutex );
+		for ( ;; )
+		{
+			// nothing new starts after a failure, what is running is waited on
+			Node* main_step { nullptr };
+			bool pending { false };
+			for ( auto& node : steps_ )
+			{
+				if ( node.started_ )
+				{
+					continue;
+				}
+				pending = true;
+				if ( error )
+				{
+					continue;
+				}
+
+				bool ready { true };
+				for ( Step dependency : node.dependencies_ )
+				{
+					ready = ready && steps_[ dependency ].done_;
+				}
+				if ( !ready )
+				{
+					continue;
+				}
+
+				if ( node.thread_ == Thread::WORKER )
+				{
+					node.started_ = true;
+					++running;
+					workers.emplace_back ( execute , std::ref ( node ) );
+				}
+				else if ( main_step == nullptr )
+				{
+					main_step = &node;
+				}
+			}
+
+			if ( main_step != nullptr )
+			{
+				main_step->started_ = true;
+				++running;
+				lock.unlock ();
+				execute ( *main_step );
+				lock.lock ();
+				continue;
+			}
+
+			if ( running == 0 && ( !pending || error ) )
+			{
+				break;
+			}
+			finished.wait ( lock );
+		}
+		lock.unlock ();
+
+		for ( auto& worker : workers )
+		{
+			worker.join ();
+		}
+		wall_ms_ = elapsed_ms ();
+
+		if ( error )
+		{
+			std::rethrow_exception ( error );
+		}
+	}
+
+	void StartupGraph::Report () const
+	{
+		double serial_ms { 0.0 };
+		std::printf ( "startup steps (ms from start):\n" );
+		std::printf ( "  %-24s %-7s %10s %10s\n" , "step" , "thread" , "start" , "duration" );
+		for ( auto const& node : steps_ )
+		{
+			if ( !node.done_ )
+			{
+				std::printf ( "  %-24s %-7s %10s %10s\n" , node.name_.c_str () , node.thread_ == Thread::MAIN ? "main" : "worker" , "-" , "-" );
+				continue;
+			}
+			std::printf ( "  %-24s %-7s %10.3f %10.3f\n" , node.name_.c_str () , node.thread_ == Thread::MAIN ? "main" : "worker" ,
+						  node.start_ms_ , node.duration_ms_ );
+			serial_ms += node.duration_ms_;
+		}
+		// the difference is what running steps side by side saved
+		std::printf ( "  wall %.3f ms, %.3f ms if run one after another\n" , wall_ms_ , serial_ms );
+	}
+}
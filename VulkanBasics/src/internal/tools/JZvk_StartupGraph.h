@@ -0,0 +1,61 @@
+/* STARTUP STEPS RUN CONCURRENTLY IN DEPENDENCY ORDER, WITH TIMINGS */
+#pragma once
+
+/* STD INCLUDES */
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace JZvk
+{
+	/*!
+	 * @brief ___JZvk::StartupGraph___
+	 * **************************************************************
+	 * Steps of a startup sequence and the steps each one needs
+	 * finished first. Run() starts every step as soon as its
+	 * dependencies are done, worker steps on a thread of their own
+	 * and main steps, e.g. anything touching glfw, on the calling
+	 * thread. A step may only depend on steps added before it, so
+	 * the graph cannot have cycles.
+	 *
+	 * Every step is timed from the start of Run(), Report() prints
+	 * the breakdown along with the wall time, which is the time to
+	 * the first frame as far as initialization goes.
+	 * **************************************************************
+	*/
+	class StartupGraph
+	{
+	public:
+		using Step = size_t;
+
+		enum class Thread
+		{
+			MAIN ,
+			WORKER
+		};
+
+		Step Add ( std::string name , std::function<void ()> task , std::vector<Step> dependencies = {} , Thread thread = Thread::WORKER );
+
+		// blocks until every step has run, the first exception a step threw is rethrown once the others are done
+		void Run ();
+
+		void Report () const;
+
+	private:
+		struct Node
+		{
+			std::string name_;
+			std::function<void ()> task_;
+			std::vector<Step> dependencies_;
+			Thread thread_ { Thread::WORKER };
+			bool started_ { false };
+			bool done_ { false };
+			double start_ms_ { 0.0 };
+			double duration_ms_ { 0.0 };
+		};
+
+		std::vector<Node> steps_;
+		double wall_ms_ { 0.0 };
+	};
+}
@@ -2,6 +2,8 @@
 #include <GLFW/glfw3.h>
 
 /* STD INCLUDES */
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <set>
 #include <string>
@@ -11,6 +13,41 @@
 
 namespace JZvk
 {
+    // physical device and surface query calls, see QueryCallCount. startup graph steps count from worker threads
+    static std::atomic<uint32_t> query_calls { 0 };
+
+    void CountQueryCalls ( uint32_t count )
+    {
+        query_calls.fetch_add ( count , std::memory_order_relaxed );
+    }
+
+    uint32_t QueryCallCount ()
+    {
+        return query_calls.load ( std::memory_order_relaxed );
+    }
+
+    std::vector<VkExtensionProperties> EnumerateDeviceExtensions ( VkPhysicalDevice device )
+    {
+        uint32_t extension_count;
+        vkEnumerateDeviceExtensionProperties ( device , nullptr , &extension_count , nullptr );
+        std::vector<VkExtensionProperties> available_extensions ( extension_count );
+        vkEnumerateDeviceExtensionProperties ( device , nullptr , &extension_count , available_extensions.data () );
+        CountQueryCalls ( 2 );
+        return available_extensions;
+    }
+
+    bool HasExtension ( std::vector<VkExtensionProperties> const& availableExtensions , char const* extension )
+    {
+        for ( auto const& available_extension : availableExtensions )
+        {
+            if ( strcmp ( available_extension.extensionName , extension ) == 0 )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     std::vector<char const*> GetValidationLayers ()
     {
         return {
@@ -18,13 +55,40 @@ namespace JZvk
         };
     }
 
-    std::vector<char const*> GetDeviceExtensions ()
+    std::vector<char const*> GetDeviceExtensions ( bool presenting )
     {
+        if ( !presenting )
+        {
+            return {};
+        }
         return {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME
         };
     }
 
+    std::vector<char const*> GetDeviceExtensions ( DeviceCapabilities const& capabilities , bool presenting )
+    {
+        std::vector<char const*> extensions = GetDeviceExtensions ( presenting );
+        if ( capabilities.extended_dynamic_state_ )
+        {
+            extensions.push_back ( VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME );
+        }
+        if ( capabilities.descriptor_indexing_ )
+        {
+            extensions.push_back ( VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME );
+        }
+        if ( capabilities.push_descriptor_ )
+        {
+            extensions.push_back ( VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME );
+        }
+        if ( capabilities.graphics_pipeline_library_ )
+        {
+            extensions.push_back ( VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME );
+            extensions.push_back ( VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME );
+        }
+        return extensions;
+    }
+
     //std::vector<VkExtensionProperties> GetVulkanAvailableExtensions ()
     //{
     //    uint32_t extension_count { 0 };
@@ -85,14 +149,14 @@ namespace JZvk
         return true;
 	}
 
-    bool CheckDeviceExtensionsSupport ( VkPhysicalDevice device )
+    bool CheckDeviceExtensionsSupport ( VkPhysicalDevice device , bool presenting )
     {
-        uint32_t extension_count;
-        vkEnumerateDeviceExtensionProperties ( device , nullptr , &extension_count , nullptr );
-        std::vector<VkExtensionProperties> available_extensions ( extension_count );
-        vkEnumerateDeviceExtensionProperties ( device , nullptr , &extension_count , available_extensions.data () );
+        return CheckDeviceExtensionsSupport ( EnumerateDeviceExtensions ( device ) , presenting );
+    }
 
-        std::vector<char const*> device_extensions = GetDeviceExtensions ();
+    bool CheckDeviceExtensionsSupport ( std::vector<VkExtensionProperties> const& availableExtensions , bool presenting )
+    {
+        std::vector<char const*> device_extensions = GetDeviceExtensions ( presenting );
         std::set<std::string> required_extensions ( device_extensions.begin () , device_extensions.end () );
 
         Log ( LOG::INFO , "__________________________________________________" );
@@ -104,23 +168,149 @@ namespace JZvk
             Log ( LOG::INFO , "\t" , extension );
         }
         Log ( LOG::INFO , "Available vulkan extensions:" );
-        for ( auto const& extension : available_extensions )
+        for ( auto const& extension : availableExtensions )
         {
             Log ( LOG::INFO , "\t" , extension.extensionName );
         }
-        for ( auto const& extension : available_extensions )
+        for ( auto const& extension : availableExtensions )
         {
             required_extensions.erase ( extension.extensionName );
         }
         if ( !required_extensions.empty () )
         {
-            Log ( LOG::ERROR , "Required device extensions not supported by device." );
+            Log ( LOG::ERROR , "Required device extensions not supported by device:" );
+            for ( auto const& extension : required_extensions )
+            {
+                Log ( LOG::ERROR , "\t" , extension );
+            }
+            Log ( LOG::INFO , "__________________________________________________" );
+            return false;
         }
         Log ( LOG::INFO , "All device required extensions found." );
         Log ( LOG::INFO , "__________________________________________________" );
         return true;
     }
 
+    bool CheckDeviceExtensionSupport ( VkPhysicalDevice device , char const* extension )
+    {
+        return HasExtension ( EnumerateDeviceExtensions ( device ) , extension );
+    }
+
+    DeviceCapabilities GetDeviceCapabilities ( VkPhysicalDevice device )
+    {
+        // enumerated once for every optional extension below
+        return GetDeviceCapabilities ( device , EnumerateDeviceExtensions ( device ) );
+    }
+
+    DeviceCapabilities GetDeviceCapabilities ( VkPhysicalDevice device , std::vector<VkExtensionProperties> const& availableExtensions )
+    {
+        DeviceCapabilities capabilities;
+
+        // feature structs are chained so a single query fills them all
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state {};
+        extended_dynamic_state.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+
+        VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing {};
+        descriptor_indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipeline_library {};
+        pipeline_library.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+        VkPhysicalDeviceFeatures2 features {};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        if ( HasExtension ( availableExtensions , VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME ) )
+        {
+            extended_dynamic_state.pNext = features.pNext;
+            features.pNext = &extended_dynamic_state;
+        }
+        bool const has_descriptor_indexing = HasExtension ( availableExtensions , VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME );
+        if ( has_descriptor_indexing )
+        {
+            descriptor_indexing.pNext = features.pNext;
+            features.pNext = &descriptor_indexing;
+        }
+        bool const has_pipeline_library = HasExtension ( availableExtensions , VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME )
+            && HasExtension ( availableExtensions , VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME );
+        if ( has_pipeline_library )
+        {
+            pipeline_library.pNext = features.pNext;
+            features.pNext = &pipeline_library;
+        }
+        vkGetPhysicalDeviceFeatures2 ( device , &features );
+        CountQueryCalls ( 1 );
+
+        capabilities.extended_dynamic_state_ = extended_dynamic_state.extendedDynamicState == VK_TRUE;
+        capabilities.pipeline_statistics_query_ = features.features.pipelineStatisticsQuery == VK_TRUE;
+        capabilities.occlusion_query_precise_ = features.features.occlusionQueryPrecise == VK_TRUE;
+
+        // the subset the bindless table relies on, see Create::VKLogicalDevice
+        capabilities.descriptor_indexing_ = has_descriptor_indexing
+            && descriptor_indexing.runtimeDescriptorArray
+            && descriptor_indexing.descriptorBindingPartiallyBound
+            && descriptor_indexing.descriptorBindingUpdateUnusedWhilePending
+            && descriptor_indexing.descriptorBindingSampledImageUpdateAfterBind
+            && descriptor_indexing.descriptorBindingStorageBufferUpdateAfterBind
+            && descriptor_indexing.shaderSampledImageArrayNonUniformIndexing
+            && descriptor_indexing.shaderStorageBufferArrayNonUniformIndexing;
+
+        if ( capabilities.descriptor_indexing_ )
+        {
+            VkPhysicalDeviceDescriptorIndexingProperties indexing_properties {};
+            indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+            VkPhysicalDeviceProperties2 properties {};
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties.pNext = &indexing_properties;
+            vkGetPhysicalDeviceProperties2 ( device , &properties );
+            CountQueryCalls ( 1 );
+
+            capabilities.max_bindless_sampled_images_ = std::min ( indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages ,
+                                                                   indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages );
+            capabilities.max_bindless_storage_buffers_ = std::min ( indexing_properties.maxDescriptorSetUpdateAfterBindStorageBuffers ,
+                                                                    indexing_properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers );
+        }
+
+        // push descriptors have no feature bit, only a limit
+        if ( HasExtension ( availableExtensions , VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME ) )
+        {
+            VkPhysicalDevicePushDescriptorPropertiesKHR push_properties {};
+            push_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+
+            VkPhysicalDeviceProperties2 properties {};
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties.pNext = &push_properties;
+            vkGetPhysicalDeviceProperties2 ( device , &properties );
+            CountQueryCalls ( 1 );
+
+            capabilities.push_descriptor_ = push_properties.maxPushDescriptors > 0;
+            capabilities.max_push_descriptors_ = push_properties.maxPushDescriptors;
+        }
+
+        capabilities.graphics_pipeline_library_ = has_pipeline_library && pipeline_library.graphicsPipelineLibrary == VK_TRUE;
+        if ( capabilities.graphics_pipeline_library_ )
+        {
+            VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT library_properties {};
+            library_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+
+            VkPhysicalDeviceProperties2 properties {};
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties.pNext = &library_properties;
+            vkGetPhysicalDeviceProperties2 ( device , &properties );
+            CountQueryCalls ( 1 );
+
+            capabilities.fast_linking_ = library_properties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+        }
+
+        Log ( LOG::INFO , "__________________________________________________" );
+        Log ( LOG::INFO , "OPTIONAL DEVICE FEATURES:" );
+        Log ( LOG::INFO , "\t" , "extended dynamic state: " , capabilities.extended_dynamic_state_ ? "yes" : "no" );
+        Log ( LOG::INFO , "\t" , "descriptor indexing: " , capabilities.descriptor_indexing_ ? "yes" : "no" );
+        Log ( LOG::INFO , "\t" , "push descriptors: " , capabilities.push_descriptor_ ? "yes" : "no" );
+        Log ( LOG::INFO , "\t" , "graphics pipeline library: " , capabilities.graphics_pipeline_library_ ? ( capabilities.fast_linking_ ? "yes, fast linking" : "yes" ) : "no" );
+        Log ( LOG::INFO , "__________________________________________________" );
+        return capabilities;
+    }
+
     SwapChainSupportDetails GetSwapChainSupport ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface )
     {
         SwapChainSupportDetails details;
@@ -145,6 +335,7 @@ namespace JZvk
             details.present_modes_.resize ( present_modes_count );
             vkGetPhysicalDeviceSurfacePresentModesKHR ( physicalDevice , surface , &present_modes_count , details.present_modes_.data () );
         }
+        CountQueryCalls ( 3 + ( format_count != 0 ) + ( present_modes_count != 0 ) );
 
         return details;
     }
@@ -207,18 +398,24 @@ namespace JZvk
 
     QueueFamilyIndices FindQueueFamilies ( VkPhysicalDevice device , VkSurfaceKHR surface )
     {
-        QueueFamilyIndices indices;
-
         // get all device queue families
         uint32_t qfp_count = 0;
         vkGetPhysicalDeviceQueueFamilyProperties ( device , &qfp_count , nullptr );
         std::vector<VkQueueFamilyProperties> queue_families_properties ( qfp_count );
         vkGetPhysicalDeviceQueueFamilyProperties ( device , &qfp_count , queue_families_properties.data () );
+        CountQueryCalls ( 2 );
+
+        return FindQueueFamilies ( device , surface , queue_families_properties );
+    }
+
+    QueueFamilyIndices FindQueueFamilies ( VkPhysicalDevice device , VkSurfaceKHR surface , std::vector<VkQueueFamilyProperties> const& queueFamilies )
+    {
+        QueueFamilyIndices indices;
 
         // store them in self made queue family struct, i.e. QueueFamilyIndices
         // graphics and present family share the same index
         int i = 0;
-        for ( const auto& qfp : queue_families_properties )
+        for ( const auto& qfp : queueFamilies )
         {
             // look for graphics bit
             if ( qfp.queueFlags & VK_QUEUE_GRAPHICS_BIT )
@@ -226,9 +423,21 @@ namespace JZvk
                 indices.graphics_family_ = i;
             }
 
+            // headless, nothing to present to
+            if ( surface == VK_NULL_HANDLE )
+            {
+                if ( indices.graphics_family_.has_value () )
+                {
+                    break;
+                }
+                ++i;
+                continue;
+            }
+
             // look for present support
             VkBool32 presentSupport = false;
             vkGetPhysicalDeviceSurfaceSupportKHR ( device , i , surface , &presentSupport );
+            CountQueryCalls ( 1 );
             if ( presentSupport )
             {
                 indices.present_family_ = i;
@@ -247,6 +456,11 @@ namespace JZvk
 
     bool IsDeviceSuitable ( VkPhysicalDevice device , VkSurfaceKHR surface )
     {
+        if ( surface == VK_NULL_HANDLE )
+        {
+            return FindQueueFamilies ( device , surface ).graphics_family_.has_value () &&
+                CheckDeviceExtensionsSupport ( device , false );
+        }
         return FindQueueFamilies ( device , surface ).IsComplete () &&
             CheckDeviceExtensionsSupport ( device ) &&
             CheckSwapChainSupport ( device , surface );
@@ -13,7 +13,7 @@ namespace JZvk
 		std::optional<uint32_t> graphics_family_;
 		std::optional<uint32_t> present_family_;
 
-		bool IsComplete ()
+		bool IsComplete () const
 		{
 			return graphics_family_.has_value ()
 				&& present_family_.has_value ();
@@ -27,8 +27,45 @@ namespace JZvk
 		std::vector<VkPresentModeKHR> present_modes_;
 	};
 
+	/*!
+	 * @brief ___JZvk::DeviceCapabilities___
+	 * **************************************************************
+	 * Optional device features the renderer uses when present.
+	 * Filled by GetDeviceCapabilities() and enabled on the logical
+	 * device by Create::VKLogicalDevice().
+	 * **************************************************************
+	*/
+	struct DeviceCapabilities
+	{
+		// VK_EXT_extended_dynamic_state, cull mode, front face, topology and depth state set per draw
+		bool extended_dynamic_state_ { false };
+
+		// VK_EXT_descriptor_indexing, partially bound update-after-bind arrays for bindless resources
+		bool descriptor_indexing_ { false };
+		uint32_t max_bindless_sampled_images_ { 0 };
+		uint32_t max_bindless_storage_buffers_ { 0 };
+
+		// VK_KHR_push_descriptor, per draw bindings written into the command buffer
+		bool push_descriptor_ { false };
+		uint32_t max_push_descriptors_ { 0 };
+
+		// VK_EXT_graphics_pipeline_library, pipelines linked from separately compiled stage libraries
+		bool graphics_pipeline_library_ { false };
+		bool fast_linking_ { false };
+
+		// pipelineStatisticsQuery, per pass shader invocation and primitive counts
+		bool pipeline_statistics_query_ { false };
+
+		// occlusionQueryPrecise, occlusion queries count samples instead of only being nonzero
+		bool occlusion_query_precise_ { false };
+	};
+
 	std::vector<char const*> GetValidationLayers ();
-	std::vector<char const*> GetDeviceExtensions ();
+	// presenting adds the swap chain extension, headless devices do without it
+	std::vector<char const*> GetDeviceExtensions ( bool presenting = true );
+
+	// required device extensions plus the optional ones enabled by capabilities
+	std::vector<char const*> GetDeviceExtensions ( DeviceCapabilities const& capabilities , bool presenting = true );
 
 	/* CHECK VARIOUS SUPPORTS */
 	/*!
@@ -56,7 +93,7 @@ namespace JZvk
 	bool CheckGLFWExtensionsSupport ( char const** glfwExtensions , unsigned int glfwExtensionCount );
 
 	/*!
-	 * @brief ___JZvk::CheckValidationLayerSupport()___
+	 * @brief ___JZvk::CheckDeviceExtensionsSupport()___
 	 * **************************************************************
 	 * Checks if device extensions required by GetDeviceExtensions()
 	 * are supported by the device.
@@ -65,7 +102,42 @@ namespace JZvk
 	 * : If supported.
 	 * **************************************************************
 	*/
-	bool CheckDeviceExtensionsSupport ( VkPhysicalDevice device );
+	bool CheckDeviceExtensionsSupport ( VkPhysicalDevice device , bool presenting = true );
+
+	// same, against an already enumerated extension list
+	bool CheckDeviceExtensionsSupport ( std::vector<VkExtensionProperties> const& availableExtensions , bool presenting = true );
+
+	// every extension the device supports
+	std::vector<VkExtensionProperties> EnumerateDeviceExtensions ( VkPhysicalDevice device );
+
+	bool HasExtension ( std::vector<VkExtensionProperties> const& availableExtensions , char const* extension );
+
+	/*!
+	 * @brief ___JZvk::CheckDeviceExtensionSupport()___
+	 * **************************************************************
+	 * Checks if a single, optional extension is supported by the
+	 * device. Does not log.
+	 * **************************************************************
+	 * @return bool
+	 * : If supported.
+	 * **************************************************************
+	*/
+	bool CheckDeviceExtensionSupport ( VkPhysicalDevice device , char const* extension );
+
+	/*!
+	 * @brief ___JZvk::GetDeviceCapabilities()___
+	 * **************************************************************
+	 * Queries which optional features the device supports, an
+	 * extension counts only if its feature bits are also set.
+	 * **************************************************************
+	 * @return DeviceCapabilities
+	 * : Supported optional features.
+	 * **************************************************************
+	*/
+	DeviceCapabilities GetDeviceCapabilities ( VkPhysicalDevice device );
+
+	// same, with the device's extensions already enumerated
+	DeviceCapabilities GetDeviceCapabilities ( VkPhysicalDevice device , std::vector<VkExtensionProperties> const& availableExtensions );
 
 	/*!
 	 * @brief ___JZvk::CheckSwapChainSupport()___
@@ -79,7 +151,27 @@ namespace JZvk
 	SwapChainSupportDetails GetSwapChainSupport ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
 	bool CheckSwapChainSupport ( VkPhysicalDevice physicalDevice , VkSurfaceKHR surface );
 
+	// without a surface only the graphics family is looked for
 	QueueFamilyIndices FindQueueFamilies ( VkPhysicalDevice device , VkSurfaceKHR surface );
 
+	// same, from already enumerated queue family properties
+	QueueFamilyIndices FindQueueFamilies ( VkPhysicalDevice device , VkSurfaceKHR surface , std::vector<VkQueueFamilyProperties> const& queueFamilies );
+
+	// a null surface selects for headless rendering, present support is not required
 	bool IsDeviceSuitable ( VkPhysicalDevice device , VkSurfaceKHR surface );
+
+	/*!
+	 * @brief ___JZvk::QueryCallCount()___
+	 * **************************************************************
+	 * Physical device, queue family and surface query calls made so
+	 * far by these functions and GetDeviceContext(), for startup
+	 * traces. CountQueryCalls() adds calls made elsewhere, from any
+	 * thread.
+	 * **************************************************************
+	 * @return uint32_t
+	 * : Vulkan calls made.
+	 * **************************************************************
+	*/
+	uint32_t QueryCallCount ();
+	void CountQueryCalls ( uint32_t count );
 }
\ No newline at end of file